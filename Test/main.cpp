@@ -3,6 +3,19 @@
 #include "doctest.h"
 
 #include "../expression_parser.hpp"
+#include "../thread_pool.hpp"
+#include "../lu_decomposition.hpp"
+#include "../matrix_loader.hpp"
+#include "../expression_simplifier.hpp"
+#include "../polynomial.hpp"
+#include "../expression_eliminator.hpp"
+#include "../calculus.hpp"
+
+#include <atomic>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <unordered_set>
 
 TEST_CASE("ExpressionParser::ExpressionParser") {
     SUBCASE("Empty expression") {
@@ -29,3 +42,1547 @@ TEST_CASE("ExpressionParser::Parse") {
         CHECK_THROWS_AS(ExpressionParser expression_parser("undefined * 2"); expression_parser.Parse(), std::invalid_argument const &);
     }
 }
+
+TEST_CASE("Matrix::Determinant") {
+    SUBCASE("Numeric matrix") {
+        ExpressionParser expression_parser("det\\left(\\begin{bmatrix} 2 & 0 & 1 \\\\ 1 & 3 & 2 \\\\ 1 & 1 & 2 \\end{bmatrix}\\right)");
+
+        Scalar determinant = std::get<Scalar>(expression_parser.Parse());
+
+        CHECK(determinant->Type() == "ConstantNode");
+        CHECK(Approximately(determinant->Value(), 6.0));
+    }
+
+    SUBCASE("Symbolic matrix") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        ExpressionParser expression_parser("det\\left(\\begin{bmatrix} x & 0 & 1 \\\\ 1 & 3 & 2 \\\\ 1 & 1 & 2 \\end{bmatrix}\\right)", { { "x", x } });
+
+        Scalar determinant = std::get<Scalar>(expression_parser.Parse());
+
+        CHECK(Approximately(determinant->Value(), 6.0));
+
+        *x = 0.5;
+
+        CHECK(Approximately(determinant->Value(), 0.0));
+    }
+
+    SUBCASE("Large numeric matrix") {
+        Matrix matrix(12, 12);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                matrix(i, j) = Scalar(new ConstantNode(i == j ? 2.0 : (j == i + 1 ? 1.0 : 0.0)));
+            }
+        }
+
+        CHECK(Approximately(matrix.Determinant()->Value(), 4096.0));
+    }
+
+    SUBCASE("Large symbolic matrix") {
+        std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+
+        Matrix matrix(8, 8);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                if (i == j) {
+                    matrix(i, j) = Scalar(new MultiplicationNode({ Scalar(new ConstantNode(static_cast<double>(i))), x }));
+                }
+                else {
+                    matrix(i, j) = Scalar(new ConstantNode(static_cast<double>((i * 3 + j * 5) % 7) - 3.0));
+                }
+            }
+        }
+
+        Scalar determinant = matrix.Determinant();
+
+        CHECK(Approximately(determinant->Value(), matrix.DeterminantValue(), 1e-6));
+
+        *x = -1.25;
+
+        CHECK(Approximately(determinant->Value(), matrix.DeterminantValue(), 1e-6));
+        CHECK(Approximately(matrix.Minor(0, 0, Matrix::Method::Berkowitz)->Value(), matrix.Minor(0, 0, Matrix::Method::LU)->Value(), 1e-6));
+    }
+
+    SUBCASE("Symbolic matrix after its pivot vanishes") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        Matrix matrix(4, 4, {
+            x, Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(2.0)), Scalar(new ConstantNode(0.0)),
+            Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(2.0)),
+            Scalar(new ConstantNode(2.0)), Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(1.0)),
+            Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(2.0)), Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(1.0))
+        });
+
+        // Built while x = 2, where elimination would have picked x as its first pivot
+        Scalar determinant = matrix.Determinant();
+        Matrix inverse = matrix.Inverse();
+        Matrix solution = matrix.Solve(Matrix(4, 1, { Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(2.0)), Scalar(new ConstantNode(3.0)), Scalar(new ConstantNode(4.0)) }));
+
+        *x = 0.0;
+
+        CHECK(Approximately(determinant->Value(), matrix.DeterminantValue(), 1e-6));
+        CHECK(Approximately(determinant->Value(), matrix.Determinant(Matrix::Method::Cofactor)->Value(), 1e-6));
+
+        Matrix inverse_value = matrix.InverseValue();
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                CHECK(Approximately(inverse(i, j)->Value(), inverse_value(i, j)->Value(), 1e-6));
+            }
+
+            CHECK(!std::isnan(solution(i, 0)->Value().real()));
+        }
+    }
+
+    SUBCASE("Symbolic matrix whose leading minor vanishes") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        Matrix matrix(4, 4, {
+            x, Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)),
+            Scalar(new ConstantNode(1.0)), x, Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)),
+            Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)),
+            Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(1.0))
+        });
+
+        Scalar determinant = matrix.Determinant();
+        Scalar berkowitz = matrix.Determinant(Matrix::Method::Berkowitz);
+        Matrix cofactor = matrix.Cofactor();
+
+        *x = 0.0;
+
+        CHECK(Approximately(determinant->Value(), -1.0, 1e-9));
+        CHECK(Approximately(berkowitz->Value(), -1.0, 1e-9));
+        CHECK(Approximately(cofactor(0, 1)->Value(), -1.0, 1e-9));
+        CHECK(Approximately(cofactor(3, 3)->Value(), -1.0, 1e-9));
+    }
+}
+
+TEST_CASE("Matrix::Inverse") {
+    SUBCASE("Numeric matrix") {
+        ExpressionParser expression_parser("inv\\left(\\begin{bmatrix} 0 & 2 \\\\ 4 & 0 \\end{bmatrix}\\right)");
+
+        Matrix inverse = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(Approximately(inverse(0, 0)->Value(), 0.0));
+        CHECK(Approximately(inverse(0, 1)->Value(), 0.25));
+        CHECK(Approximately(inverse(1, 0)->Value(), 0.5));
+        CHECK(Approximately(inverse(1, 1)->Value(), 0.0));
+    }
+
+    SUBCASE("Symbolic matrix") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        Matrix matrix(5, 5);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                matrix(i, j) = i == j ? Scalar(new AdditionNode({ x, Scalar(new ConstantNode(static_cast<double>(i))) })) : Scalar(new ConstantNode(static_cast<double>((i + 2 * j) % 3)));
+            }
+        }
+
+        Matrix inverse = matrix.Inverse();
+        Matrix cofactor = matrix.Cofactor();
+        Matrix cofactor_expansion = matrix.Cofactor(Matrix::Method::Cofactor);
+
+        for (double value : { 2.0, -0.5 }) {
+            *x = value;
+
+            Matrix inverse_value = matrix.InverseValue();
+
+            for (size_t i = 0; i < matrix.Rows(); ++i) {
+                for (size_t j = 0; j < matrix.Cols(); ++j) {
+                    CHECK(Approximately(inverse(i, j)->Value(), inverse_value(i, j)->Value(), 1e-6));
+                    CHECK(Approximately(cofactor(i, j)->Value(), cofactor_expansion(i, j)->Value(), 1e-6));
+                }
+            }
+        }
+    }
+
+    SUBCASE("Singular matrix") {
+        ExpressionParser expression_parser("inv\\left(\\begin{bmatrix} 1 & 2 \\\\ 2 & 4 \\end{bmatrix}\\right)");
+
+        CHECK_THROWS_AS(expression_parser.Parse(), std::invalid_argument const &);
+    }
+}
+
+TEST_CASE("NumericMatrix") {
+    SUBCASE("Blocked product") {
+        NumericMatrix lhs(70, 130);
+        NumericMatrix rhs(130, 90);
+
+        for (size_t i = 0; i < lhs.Rows(); ++i) {
+            for (size_t j = 0; j < lhs.Cols(); ++j) {
+                lhs.Set(i, j, std::complex<double>(static_cast<double>((i + j) % 5), static_cast<double>((i * j) % 3)));
+            }
+        }
+
+        for (size_t i = 0; i < rhs.Rows(); ++i) {
+            for (size_t j = 0; j < rhs.Cols(); ++j) {
+                rhs.Set(i, j, static_cast<double>((2 * i + j) % 7) - 3.0);
+            }
+        }
+
+        NumericMatrix product = lhs.Multiply(rhs);
+
+        for (size_t i = 0; i < product.Rows(); i += 7) {
+            for (size_t j = 0; j < product.Cols(); j += 11) {
+                std::complex<double> sum = 0.0;
+
+                for (size_t k = 0; k < lhs.Cols(); ++k) {
+                    sum += lhs(i, k) * rhs(k, j);
+                }
+
+                CHECK(Approximately(product(i, j), sum));
+            }
+        }
+
+        NumericMatrix transpose = product.Transpose();
+
+        CHECK(Approximately(transpose(89, 69), product(69, 89)));
+    }
+
+    SUBCASE("Numeric sums stay numeric") {
+        Matrix const lhs(NumericMatrix(2, 2, { 1.0, 2.0, 3.0, 4.0 }));
+        Matrix const rhs(NumericMatrix(2, 2, { 4.0, 3.0, 2.0, 1.0 }));
+
+        Matrix sum = lhs.Add(rhs);
+        Matrix difference = lhs.Subtract(rhs);
+
+        // Both operands hold their values contiguously, so no elementwise expression is recorded
+        CHECK(!sum.Expression());
+        CHECK(!difference.Expression());
+        CHECK(Approximately(sum.Value(1, 0), 5.0));
+        CHECK(Approximately(difference.Value(1, 1), 3.0));
+    }
+
+    SUBCASE("Numeric operands in the parser") {
+        ExpressionParser expression_parser("\\begin{bmatrix} 1 & 2 \\\\ 3 & 4 \\end{bmatrix} * \\begin{bmatrix} 1 \\\\ 1 \\end{bmatrix} + 2 * \\begin{bmatrix} 1 \\\\ 0 \\end{bmatrix}");
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Rows() == 2);
+        CHECK(matrix.Cols() == 1);
+        CHECK(Approximately(matrix(0, 0)->Value(), 5.0));
+        CHECK(Approximately(matrix(1, 0)->Value(), 7.0));
+    }
+}
+
+TEST_CASE("Matrix::Pow") {
+    SUBCASE("Markov chain") {
+        ExpressionParser expression_parser("\\begin{bmatrix} 0.9 & 0.1 \\\\ 0.5 & 0.5 \\end{bmatrix} ^ {2000}");
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(Approximately(matrix(0, 0)->Value(), 5.0 / 6.0));
+        CHECK(Approximately(matrix(1, 1)->Value(), 1.0 / 6.0));
+    }
+
+    SUBCASE("Negative power") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        ExpressionParser expression_parser("\\begin{bmatrix} x & 1 \\\\ 0 & 1 \\end{bmatrix} ^ {-3}", { { "x", x } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(Approximately(matrix(0, 0)->Value(), 0.125));
+        CHECK(Approximately(matrix(0, 1)->Value(), -0.875));
+        CHECK(Approximately(matrix(1, 1)->Value(), 1.0));
+    }
+
+    SUBCASE("Non-integer power") {
+        ExpressionParser expression_parser("\\begin{bmatrix} 1 & 0 \\\\ 0 & 1 \\end{bmatrix} ^ {0.5}");
+
+        CHECK_THROWS_AS(expression_parser.Parse(), std::invalid_argument const &);
+    }
+}
+
+TEST_CASE("SparseMatrix") {
+    SUBCASE("Banded product") {
+        std::vector<std::tuple<size_t, size_t, Scalar>> triplets;
+
+        for (size_t i = 0; i < 200; ++i) {
+            triplets.emplace_back(i, i, Scalar(new ConstantNode(2.0)));
+
+            if (i + 1 < 200) {
+                triplets.emplace_back(i, i + 1, Scalar(new ConstantNode(-1.0)));
+                triplets.emplace_back(i + 1, i, Scalar(new ConstantNode(-1.0)));
+            }
+        }
+
+        SparseMatrix sparse(200, 200, triplets);
+
+        CHECK(sparse.NonZeros() == 598);
+        CHECK(Approximately(sparse.Value(5, 6), -1.0));
+        CHECK(Approximately(sparse.Value(5, 7), 0.0));
+
+        SparseMatrix square = sparse.Multiply(sparse);
+
+        CHECK(square.NonZeros() == 200 * 5 - 6);
+        CHECK(Approximately(square.Value(0, 0), 5.0));
+        CHECK(Approximately(square.Value(5, 5), 6.0));
+        CHECK(Approximately(square.Value(5, 7), 1.0));
+
+        SparseMatrix sum = square.Subtract(sparse.Scale(Scalar(new ConstantNode(4.0))));
+
+        CHECK(Approximately(sum.Value(5, 5), -2.0));
+        CHECK(Approximately(sum.Value(5, 6), 0.0));
+        CHECK(sum.NonZeros() == 200 + 2 * 198);
+
+        SparseMatrix transpose = SparseMatrix(3, 2, { Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(2.0)) }).Transpose();
+
+        CHECK(transpose.Rows() == 2);
+        CHECK(transpose.NonZeros() == 2);
+        CHECK(Approximately(transpose.Value(1, 2), 2.0));
+    }
+
+    SUBCASE("Mixed sparse and dense sums") {
+        std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+
+        std::vector<std::tuple<size_t, size_t, Scalar>> triplets = { { 0, 0, x } };
+
+        // A zero read from sparse storage is an ordinary node, so a dense entry holding it is still added
+        Matrix const sparse = Matrix(SparseMatrix(2, 2, triplets));
+
+        Scalar zero = sparse(1, 1);
+        Matrix const dense(2, 2, { zero, Scalar(new ConstantNode(1.0)), x, zero });
+
+        Matrix sum = sparse.Add(dense);
+        Matrix difference = dense.Subtract(sparse);
+
+        CHECK(sum(0, 0)->Type() == "AdditionNode");
+        CHECK(sum(0, 1) == dense(0, 1));
+        CHECK(sum(1, 0) == x);
+        CHECK(difference(0, 0)->Type() == "SubtractionNode");
+        CHECK(difference(1, 1) == zero);
+        CHECK(Approximately(sum.Value(0, 0), 3.0));
+        CHECK(Approximately(difference.Value(0, 0), -3.0));
+    }
+
+    SUBCASE("Matrix-vector product") {
+        std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+
+        std::vector<std::tuple<size_t, size_t, Scalar>> triplets;
+
+        for (size_t i = 0; i < 100; ++i) {
+            triplets.emplace_back(i, (i * 7) % 100, Scalar(new ConstantNode(static_cast<double>(i))));
+        }
+
+        Matrix sparse = Matrix(SparseMatrix(100, 100, triplets));
+        Matrix vector(100, 1);
+
+        for (size_t i = 0; i < 100; ++i) {
+            vector(i, 0) = Scalar(new MultiplicationNode({ x, Scalar(new ConstantNode(static_cast<double>(i))) }));
+        }
+
+        Matrix product = sparse.Multiply(vector);
+
+        CHECK(product.Rows() == 100);
+        CHECK(product.Cols() == 1);
+        CHECK(Approximately(product.Value(3, 0), 3.0 * 21.0 * 3.0));
+
+        *x = 1.0;
+
+        CHECK(Approximately(product.Value(3, 0), 3.0 * 21.0));
+        CHECK(Approximately(Matrix::Identity(100).Multiply(vector).Value(42, 0), 42.0));
+    }
+
+    SUBCASE("Sparse literals in the parser") {
+        std::string literal = "\\begin{bmatrix}";
+
+        for (size_t i = 0; i < 10; ++i) {
+            for (size_t j = 0; j < 10; ++j) {
+                literal += (i == j ? std::to_string(i + 1) : "0") + (j < 9 ? "&" : "");
+            }
+
+            literal += i < 9 ? "\\\\" : "\\end{bmatrix}";
+        }
+
+        ExpressionParser expression_parser(literal + " * " + literal + " - " + literal);
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Sparse());
+        CHECK(Approximately(matrix.Value(4, 4), 20.0));
+        CHECK(Approximately(matrix.Value(4, 5), 0.0));
+    }
+
+    SUBCASE("Entries below the tolerance are stored") {
+        std::shared_ptr<VariableNode> x(new VariableNode(1e-12));
+
+        std::vector<Scalar> elements;
+
+        for (size_t i = 0; i < 63; ++i) {
+            elements.push_back(Scalar(new ConstantNode(1e-12)));
+        }
+
+        elements.push_back(x);
+
+        Matrix const product = Matrix(8, 8, elements).Multiply(Matrix::Identity(8));
+
+        CHECK(product.Value(0, 0).real() == 1e-12);
+        CHECK(product.Value(7, 7).real() == 1e-12);
+
+        std::vector<std::tuple<size_t, size_t, Scalar>> triplets = { { 0, 0, Scalar(new ConstantNode(1e-12)) }, { 1, 1, Scalar(new ConstantNode(0.0)) } };
+
+        CHECK(SparseMatrix(2, 2, triplets).NonZeros() == 1);
+
+        std::string literal = "\\begin{bmatrix}";
+
+        for (size_t i = 0; i < 10; ++i) {
+            for (size_t j = 0; j < 10; ++j) {
+                literal += std::string(i == j ? "0.000000000001" : "0") + (j < 9 ? "&" : "");
+            }
+
+            literal += i < 9 ? "\\\\" : "\\end{bmatrix}";
+        }
+
+        Matrix const matrix = std::get<Matrix>(ExpressionParser(literal).Parse());
+
+        CHECK(matrix.Value(4, 4).real() == 1e-12);
+        CHECK(matrix.Value(4, 5).real() == 0.0);
+    }
+}
+
+TEST_CASE("Matrix::Solve") {
+    SUBCASE("Numeric system") {
+        ExpressionParser expression_parser("solve{\\begin{bmatrix} 2 & 1 & 1 \\\\ 1 & 3 & 2 \\\\ 1 & 0 & 0 \\end{bmatrix}}{\\begin{bmatrix} 4 \\\\ 5 \\\\ 6 \\end{bmatrix}}");
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Rows() == 3);
+        CHECK(matrix.Cols() == 1);
+        CHECK(Approximately(matrix(0, 0)->Value(), 6.0));
+        CHECK(Approximately(matrix(1, 0)->Value(), 15.0));
+        CHECK(Approximately(matrix(2, 0)->Value(), -23.0));
+    }
+
+    SUBCASE("Cached factorization") {
+        Matrix matrix(2, 2, { Scalar(new ConstantNode(4.0)), Scalar(new ConstantNode(3.0)), Scalar(new ConstantNode(6.0)), Scalar(new ConstantNode(3.0)) });
+        Matrix copy = matrix;
+
+        CHECK(matrix.Decomposition() == copy.Decomposition());
+
+        ExpressionParser expression_parser("solve{A}{\\begin{bmatrix} 1 \\\\ 0 \\end{bmatrix}} + solve{A}{\\begin{bmatrix} 0 \\\\ 1 \\end{bmatrix}}", { { "A", matrix } });
+
+        Matrix sum = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(Approximately(sum(0, 0)->Value(), 0.0));
+        CHECK(Approximately(sum(1, 0)->Value(), 1.0 / 3.0));
+
+        copy(0, 0) = Scalar(new ConstantNode(1.0));
+
+        CHECK(matrix.Decomposition() != copy.Decomposition());
+        CHECK(Approximately(copy.DeterminantValue(), -15.0));
+        CHECK(Approximately(matrix.DeterminantValue(), -6.0));
+    }
+
+    SUBCASE("Concurrent factorization") {
+        ThreadPool thread_pool(4);
+
+        for (Matrix const &matrix : { Matrix(NumericMatrix(2, 2, { 4.0, 3.0, 6.0, 3.0 })), Matrix(2, 2, { Scalar(new ConstantNode(4.0)), Scalar(new ConstantNode(3.0)), Scalar(new ConstantNode(6.0)), Scalar(new AdditionNode({ Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(2.0)) })) }) }) {
+            std::vector<std::shared_ptr<LUDecomposition const>> decompositions(64);
+            std::vector<std::complex<double>> determinants(64);
+
+            // Every worker factorizes and copies the same const matrix, and all of them must agree on one factorization
+            thread_pool.ParallelFor(decompositions.size(), [&matrix, &decompositions, &determinants](size_t const &begin, size_t const &end) {
+                for (size_t i = begin; i < end; ++i) {
+                    Matrix const copy = matrix;
+
+                    decompositions[i] = matrix.Decomposition();
+                    determinants[i] = copy.DeterminantValue();
+                }
+            });
+
+            CHECK(std::all_of(std::cbegin(decompositions), std::cend(decompositions), [&matrix](std::shared_ptr<LUDecomposition const> const &decomposition) -> bool { return decomposition == matrix.Decomposition(); }));
+            CHECK(std::all_of(std::cbegin(determinants), std::cend(determinants), [](std::complex<double> const &determinant) -> bool { return Approximately(determinant, -6.0); }));
+        }
+    }
+
+    SUBCASE("Symbolic system") {
+        std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+        std::vector<Scalar> elements;
+
+        for (size_t i = 0; i < 5; ++i) {
+            for (size_t j = 0; j < 5; ++j) {
+                elements.emplace_back(i == j ? Scalar(new AdditionNode({ x, Scalar(new ConstantNode(static_cast<double>(i + 1))) })) : Scalar(new ConstantNode(1.0 / (i + j + 1))));
+            }
+        }
+
+        Matrix matrix(5, 5, elements);
+        Matrix rhs(5, 1, { x, Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), Scalar(new ConstantNode(-1.0)), x });
+
+        Matrix solution = matrix.Solve(rhs);
+        Matrix expected = matrix.InverseValue().Multiply(rhs);
+
+        for (size_t i = 0; i < 5; ++i) {
+            CHECK(Approximately(solution.Value(i, 0), expected.Value(i, 0)));
+        }
+
+        *x = -0.5;
+
+        expected = matrix.InverseValue().Multiply(rhs);
+
+        for (size_t i = 0; i < 5; ++i) {
+            CHECK(Approximately(solution.Value(i, 0), expected.Value(i, 0)));
+        }
+    }
+
+    SUBCASE("Singular system") {
+        ExpressionParser expression_parser("solve{\\begin{bmatrix} 1 & 2 \\\\ 2 & 4 \\end{bmatrix}}{\\begin{bmatrix} 1 \\\\ 1 \\end{bmatrix}}");
+
+        CHECK_THROWS_AS(expression_parser.Parse(), std::invalid_argument const &);
+    }
+}
+
+TEST_CASE("MatrixExpression") {
+    SUBCASE("Fused numeric chain") {
+        ExpressionParser expression_parser("exp(cos(A) + 2 * A) - 1", { { "A", Matrix(NumericMatrix(200, 300, std::vector<double>(200 * 300, 0.25))) } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Expression());
+        CHECK(matrix.Numeric());
+
+        NumericMatrix numeric = matrix.Evaluate();
+
+        CHECK(numeric.Rows() == 200);
+        CHECK(numeric.Cols() == 300);
+        CHECK(Approximately(numeric(199, 299), std::exp(std::cos(0.25) + 0.5) - 1.0));
+        CHECK(Approximately(matrix.Value(7, 11), std::exp(std::cos(0.25) + 0.5) - 1.0));
+    }
+
+    SUBCASE("Symbolic chain") {
+        std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+
+        ExpressionParser expression_parser("sin(\\begin{bmatrix} x & 1 \\\\ 2 & x \\end{bmatrix}) * x + \\begin{bmatrix} 1 & 0 \\\\ 0 & 1 \\end{bmatrix}", { { "x", x } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(!matrix.Numeric());
+        CHECK(Approximately(matrix(0, 0)->Value(), std::sin(0.5) * 0.5 + 1.0));
+        CHECK(Approximately(matrix.Value(1, 0), std::sin(2.0) * 0.5));
+
+        *x = 2.0;
+
+        NumericMatrix numeric = matrix.Evaluate();
+
+        CHECK(Approximately(numeric(1, 1), std::sin(2.0) * 2.0 + 1.0));
+
+        matrix(0, 1) = x;
+
+        CHECK(!matrix.Expression());
+        CHECK(Approximately(matrix(0, 1)->Value(), 2.0));
+        CHECK(Approximately(matrix(1, 1)->Value(), std::sin(2.0) * 2.0 + 1.0));
+    }
+}
+
+TEST_CASE("Matrix views") {
+    std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+    std::vector<Scalar> elements;
+
+    for (size_t i = 0; i < 12; ++i) {
+        elements.emplace_back(i == 5 ? Scalar(x) : Scalar(new ConstantNode(static_cast<double>(i))));
+    }
+
+    Matrix const matrix(3, 4, elements);
+
+    SUBCASE("Transpose and submatrix share elements") {
+        Matrix transpose = matrix.Transpose();
+
+        CHECK(transpose.Rows() == 4);
+        CHECK(transpose.Cols() == 3);
+        CHECK(transpose(1, 1) == matrix(1, 1));
+        CHECK(transpose(3, 2) == matrix(2, 3));
+
+        Matrix submatrix = transpose.Submatrix(0, 2);
+
+        CHECK(submatrix.Rows() == 3);
+        CHECK(submatrix.Cols() == 2);
+        CHECK(submatrix(0, 1) == matrix(1, 1));
+        CHECK(submatrix(2, 0) == matrix(0, 3));
+        CHECK(Approximately(submatrix.Transpose().Value(1, 0), 2.0));
+        CHECK(!submatrix.Numeric());
+        CHECK(matrix.Submatrix(1, 1).Numeric());
+
+        Matrix row = matrix.Row(1);
+        Matrix col = transpose.Col(2);
+
+        CHECK(row.Rows() == 1);
+        CHECK(row.Cols() == 4);
+        CHECK(row(0, 3) == matrix(1, 3));
+        CHECK(col.Rows() == 4);
+        CHECK(col(2, 0) == matrix(2, 2));
+    }
+
+    SUBCASE("Writes materialize") {
+        Matrix copy = matrix;
+        Matrix transpose = matrix.Transpose();
+
+        copy(0, 0) = x;
+        transpose(0, 1) = x;
+
+        CHECK(copy(0, 0) == x);
+        CHECK(transpose(0, 1) == x);
+        CHECK(transpose(1, 0) == matrix(0, 1));
+        CHECK(Approximately(matrix.Value(0, 0), 0.0));
+        CHECK(Approximately(matrix.Value(1, 0), 4.0));
+    }
+
+    SUBCASE("Cofactor expansion over views") {
+        Matrix square(3, 3, { x, Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(2.0)), Scalar(new ConstantNode(0.0)), x, Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(0.0)), x });
+
+        CHECK(Approximately(square.Determinant()->Value(), 8.0 + 1.0 - 4.0));
+        CHECK(Approximately(square.Transpose().Determinant()->Value(), 5.0));
+    }
+}
+
+TEST_CASE("ExpressionParser matrix chains") {
+    std::shared_ptr<VariableNode> x(new VariableNode(2.0));
+
+    std::vector<Scalar> elements;
+
+    for (size_t i = 0; i < 9; ++i) {
+        elements.emplace_back(Scalar(new MultiplicationNode({ x, Scalar(new ConstantNode(static_cast<double>(i))) })));
+    }
+
+    Matrix square(3, 3, elements);
+    Matrix vector(3, 1, { x, Scalar(new ConstantNode(1.0)), x });
+
+    SUBCASE("Matrix-vector chain is folded right to left") {
+        ExpressionParser expression_parser("A*B*v", { { "A", square }, { "B", square.Transpose() }, { "v", vector } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Rows() == 3);
+        CHECK(matrix.Cols() == 1);
+
+        // A * (B * v) leaves a sum in the right operand of each outer product
+        CHECK(matrix(0, 0)->Argument(1)->Argument(1)->Type() == "AdditionNode");
+
+        Matrix expected = square.Multiply(square.Transpose()).Multiply(vector);
+
+        for (size_t i = 0; i < 3; ++i) {
+            CHECK(Approximately(matrix.Value(i, 0), expected.Value(i, 0)));
+        }
+    }
+
+    SUBCASE("Row vector chain is folded left to right") {
+        ExpressionParser expression_parser("2*w*A*B*x", { { "A", square }, { "B", square }, { "w", vector.Transpose() }, { "x", x } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Rows() == 1);
+        CHECK(matrix.Cols() == 3);
+
+        Matrix expected = vector.Transpose().Multiply(square).Multiply(square);
+
+        for (size_t j = 0; j < 3; ++j) {
+            CHECK(Approximately(matrix.Value(0, j), 4.0 * expected.Value(0, j)));
+        }
+    }
+
+    SUBCASE("Nonconformable chain") {
+        ExpressionParser expression_parser("A*v*B", { { "A", square }, { "B", square }, { "v", vector } });
+
+        CHECK_THROWS_AS(expression_parser.Parse(), std::invalid_argument const &);
+    }
+}
+
+TEST_CASE("ThreadPool") {
+    SUBCASE("Uneven work is covered exactly once") {
+        ThreadPool thread_pool(3);
+
+        std::vector<std::atomic<size_t>> visits(5000);
+
+        thread_pool.ParallelFor(visits.size(), [&visits](size_t const &begin, size_t const &end) {
+            for (size_t index = begin; index < end; ++index) {
+                if (index < 100) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+
+                ++visits[index];
+            }
+        });
+
+        CHECK(std::all_of(std::cbegin(visits), std::cend(visits), [](std::atomic<size_t> const &count) -> bool { return count == 1; }));
+    }
+
+    SUBCASE("Exceptions reach the caller") {
+        ThreadPool thread_pool(2);
+
+        CHECK_THROWS_AS(thread_pool.ParallelFor(100, [](size_t const &begin, size_t const &end) {
+            if (begin <= 50 && 50 < end) {
+                throw std::invalid_argument("Element 50");
+            }
+        }), std::invalid_argument const &);
+    }
+
+    SUBCASE("Parallel matrix evaluation") {
+        std::shared_ptr<VariableNode> x(new VariableNode(0.25));
+
+        Matrix matrix(30, 30);
+
+        for (size_t i = 0; i < 30; ++i) {
+            for (size_t j = 0; j < 30; ++j) {
+                matrix(i, j) = Scalar(new SinNode({ Scalar(new MultiplicationNode({ x, Scalar(new ConstantNode(std::complex<double>(i, j))) })) }));
+            }
+        }
+
+        NumericMatrix numeric = matrix.Evaluate();
+
+        for (size_t i = 0; i < 30; i += 7) {
+            for (size_t j = 0; j < 30; j += 3) {
+                CHECK(Approximately(numeric(i, j), std::sin(0.25 * std::complex<double>(i, j))));
+            }
+        }
+
+        std::stringstream stream;
+
+        stream << Matrix(2, 2, { Scalar(new ConstantNode(1.0)), x, Scalar(new ConstantNode(3.0)), Scalar(new ConstantNode(4.5)) });
+
+        CHECK(stream.str() == "\\begin{bmatrix}1&0.25\\\\3&4.5\\end{bmatrix}");
+    }
+}
+
+TEST_CASE("MatrixLoader") {
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+    SUBCASE("CSV file") {
+        std::string path = (directory / "matrix_loader_test.csv").string();
+
+        std::ofstream(path) << "1, 2.5, -3\r\n4e1,+5,6\n\n";
+
+        ExpressionParser expression_parser("A * \\begin{bmatrix} 1 \\\\ 1 \\\\ 1 \\end{bmatrix}", { { "A", MatrixLoader::LoadCSV(path) } });
+
+        Matrix matrix = std::get<Matrix>(expression_parser.Parse());
+
+        CHECK(matrix.Rows() == 2);
+        CHECK(Approximately(matrix.Value(0, 0), 0.5));
+        CHECK(Approximately(matrix.Value(1, 0), 51.0));
+
+        std::ofstream(path) << "1,2\n3\n";
+
+        CHECK_THROWS_AS(MatrixLoader::LoadCSV(path), std::invalid_argument const &);
+
+        std::ofstream(path) << "1,x\n";
+
+        CHECK_THROWS_AS(MatrixLoader::LoadCSV(path), std::invalid_argument const &);
+
+        std::filesystem::remove(path);
+    }
+
+    SUBCASE("Binary file") {
+        std::string path = (directory / "matrix_loader_test.bin").string();
+
+        std::vector<double> values = { 1.0, 0.5, 2.0, -1.0, 3.0, 0.0, 4.0, 2.0 };
+
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(double));
+
+        Matrix real = MatrixLoader::LoadBinary(path, 2, 4);
+        Matrix complex = MatrixLoader::LoadBinary(path, 2, 2, true);
+
+        CHECK(real.Numeric());
+        CHECK(Approximately(real.Value(1, 2), 4.0));
+        CHECK(Approximately(complex.Value(0, 1), std::complex<double>(2.0, -1.0)));
+        CHECK(Approximately(complex.Value(1, 1), std::complex<double>(4.0, 2.0)));
+
+        CHECK_THROWS_AS(MatrixLoader::LoadBinary(path, 3, 3), std::invalid_argument const &);
+
+        // { 2^61 + 1 } * 8 wraps around to the 8 doubles in the file
+        CHECK_THROWS_AS(MatrixLoader::LoadBinary(path, (size_t(1) << 61) + 1, 8), std::invalid_argument const &);
+        CHECK_THROWS_AS(MatrixLoader::LoadBinary(path, (size_t(1) << 60) + 1, 4, true), std::invalid_argument const &);
+
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("ExpressionSimplifier::Saturate") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    std::function<size_t(Scalar const &)> size = [&size](Scalar const &scalar) -> size_t {
+        size_t count = 1;
+
+        for (Scalar const &argument : scalar->Arguments()) {
+            count += size(argument);
+        }
+
+        return count;
+    };
+
+    SUBCASE("Identities") {
+        ExpressionParser expression_parser("x + 0 * y + x^1", { { "x", x }, { "y", y } });
+
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(expression_parser.Parse()).Saturate());
+
+        CHECK(size(scalar) == 3);
+        CHECK(Approximately(scalar->Value(), 6.0));
+    }
+
+    SUBCASE("Commuted products combine") {
+        ExpressionParser expression_parser("x * y + y * x", { { "x", x }, { "y", y } });
+
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(expression_parser.Parse()).Saturate());
+
+        CHECK(size(scalar) == 5);
+        CHECK(Approximately(scalar->Value(), 30.0));
+    }
+
+    SUBCASE("Powers cancel") {
+        ExpressionParser expression_parser("\\frac{x}{y^2} * y^2", { { "x", x }, { "y", y } });
+
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(expression_parser.Parse()).Saturate());
+
+        CHECK(scalar == x);
+    }
+
+    SUBCASE("Constants fold") {
+        ExpressionParser expression_parser("2 * 3 + sin(0)");
+
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(expression_parser.Parse()).Saturate());
+
+        CHECK(scalar->Type() == "ConstantNode");
+        CHECK(Approximately(scalar->Value(), 6.0));
+    }
+
+    SUBCASE("Exhausted budget still extracts an equivalent expression") {
+        ExpressionParser expression_parser("(x + y) * (x + y) * (x + y) * (x + y)", { { "x", x }, { "y", y } });
+
+        Scalar original = std::get<Scalar>(expression_parser.Parse());
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(original).Saturate(std::chrono::milliseconds(5), 500));
+
+        CHECK(size(scalar) <= size(original));
+        CHECK(Approximately(scalar->Value(), 4096.0));
+    }
+
+    SUBCASE("Matrix elements") {
+        Matrix matrix(1, 2, { Scalar(new MultiplicationNode({ x, Scalar(new MultiplicationNode({ x, x })) })), Scalar(new SubtractionNode({ y, y })) });
+
+        Matrix simplified = std::get<Matrix>(ExpressionSimplifier(matrix).Saturate());
+
+        CHECK(simplified(0, 0)->Type() == "ExponentiationNode");
+        CHECK(simplified(0, 1)->Type() == "ConstantNode");
+        CHECK(Approximately(simplified.Value(0, 1), 0.0));
+    }
+
+    SUBCASE("Shared subexpressions extract as a DAG") {
+        Scalar scalar = x;
+        std::complex<double> value = x->Value();
+
+        for (size_t i = 0; i < 30; ++i) {
+            scalar = Scalar(new SinNode({ Scalar(new AdditionNode({ scalar, scalar })) }));
+            value = std::sin(value + value);
+        }
+
+        Scalar extracted = std::get<Scalar>(ExpressionSimplifier(scalar).Saturate(std::chrono::milliseconds(200)));
+
+        std::unordered_set<Node const *> nodes;
+
+        std::function<void(Scalar const &)> visit = [&nodes, &visit](Scalar const &scalar) {
+            if (nodes.insert(scalar.get()).second) {
+                for (Scalar const &argument : scalar->Arguments()) {
+                    visit(argument);
+                }
+            }
+        };
+
+        visit(extracted);
+
+        CHECK(nodes.size() <= 4 * 30 + 2);
+        CHECK(Approximately(std::get<std::complex<double>>(ExpressionEliminator(extracted).Bind().Evaluate()), value));
+    }
+}
+
+TEST_CASE("ExpressionSimplifier::CombineAddends") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    SUBCASE("Like terms are grouped regardless of factor order") {
+        Scalar scalar = Scalar(new MultiplicationNode({ x, y }));
+
+        for (size_t i = 0; i < 3000; ++i) {
+            if (i % 3 == 0) {
+                scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ y, Scalar(new MultiplicationNode({ Scalar(new ConstantNode(2.0)), x })) })) }));
+            }
+            else if (i % 3 == 1) {
+                scalar = Scalar(new AdditionNode({ scalar, Scalar(new ConstantNode(1.0)) }));
+            }
+            else {
+                scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ x, x })) }));
+            }
+        }
+
+        Scalar combined = std::get<Scalar>(ExpressionSimplifier(scalar).CombineAddends());
+
+        CHECK(combined->Type() == "AdditionNode");
+        CHECK(combined->Argument(0)->Type() == "AdditionNode");
+        CHECK(combined->Argument(0)->Argument(0)->Type() == "MultiplicationNode");
+        CHECK(Approximately(combined->Argument(0)->Argument(0)->Argument(0)->Value(), 2001.0));
+        CHECK(Approximately(combined->Argument(0)->Argument(1)->Value(), 1000.0));
+        CHECK(Approximately(combined->Value(), 2001.0 * 15.0 + 1000.0 + 1000.0 * 9.0));
+    }
+
+    SUBCASE("Distinct terms are combined once per chain") {
+        std::vector<std::shared_ptr<VariableNode>> variables;
+
+        Scalar scalar = Scalar(new ConstantNode(0.0));
+
+        for (size_t i = 0; i < 5000; ++i) {
+            variables.emplace_back(new VariableNode(1.0));
+
+            scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ Scalar(new ConstantNode(2.0)), variables.back() })) }));
+        }
+
+        Scalar combined = std::get<Scalar>(ExpressionSimplifier(scalar, { }, nullptr).CombineAddends());
+
+        CHECK(Approximately(combined->Value(), 10000.0));
+    }
+
+    SUBCASE("Exponents of equal bases are summed") {
+        Scalar scalar = Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, y })), Scalar(new MultiplicationNode({ Scalar(new ExponentiationNode({ x, Scalar(new ConstantNode(2.0)) })), x })) }));
+
+        Scalar combined = std::get<Scalar>(ExpressionSimplifier(scalar).CombineFactors());
+
+        CHECK(combined->Type() == "MultiplicationNode");
+        CHECK(combined->Argument(0)->Type() == "ExponentiationNode");
+        CHECK(Approximately(combined->Argument(0)->Argument(1)->Value(), 4.0));
+        CHECK(combined->Argument(1) == y);
+    }
+}
+
+TEST_CASE("ExpressionSimplifier::Factorize") {
+    std::shared_ptr<VariableNode> w(new VariableNode(2.0));
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    SUBCASE("Common factors are found regardless of factor order") {
+        Scalar sin_y = Scalar(new SinNode({ y }));
+
+        // w*sin(y) + ... + sin(y)*x*w + ... + w*y*sin(y)*x
+        Scalar scalar = Scalar(new MultiplicationNode({ w, sin_y }));
+
+        for (size_t i = 0; i < 2000; ++i) {
+            if (i % 2 == 0) {
+                scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ Scalar(new SinNode({ y })), x })), w })) }));
+            }
+            else {
+                scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ w, y })), Scalar(new MultiplicationNode({ sin_y, x })) })) }));
+            }
+        }
+
+        Scalar factorized = std::get<Scalar>(ExpressionSimplifier(scalar).Factorize());
+
+        CHECK(factorized->Type() == "MultiplicationNode");
+        CHECK(factorized->Argument(0)->Type() == "MultiplicationNode");
+        CHECK(factorized->Argument(1)->Type() == "AdditionNode");
+        CHECK(Approximately(factorized->Value(), scalar->Value()));
+    }
+
+    SUBCASE("Repeated factors are intersected as multisets") {
+        // x*x*y + x*w = x*(x*y + w)
+        Scalar scalar = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, x })), y })), Scalar(new MultiplicationNode({ x, w })) }));
+
+        Scalar factorized = std::get<Scalar>(ExpressionSimplifier(scalar).Factorize());
+
+        CHECK(factorized->Type() == "MultiplicationNode");
+        CHECK(factorized->Argument(0) == x);
+        CHECK(Approximately(factorized->Argument(1)->Value(), 3.0 * 5.0 + 2.0));
+        CHECK(Approximately(factorized->Value(), scalar->Value()));
+    }
+
+    SUBCASE("Common factors come out in a canonical order") {
+        std::shared_ptr<VariableNode> a(new VariableNode(7.0));
+        std::shared_ptr<VariableNode> b(new VariableNode(11.0));
+
+        // x*y*a + x*y*b and y*x*a + y*x*b both factor to the same product
+        Scalar xy = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, y })), a })), Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, y })), b })) }));
+        Scalar yx = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ y, x })), a })), Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ y, x })), b })) }));
+
+        Scalar xy_factorized = std::get<Scalar>(ExpressionSimplifier(xy, { }, nullptr).Factorize());
+        Scalar yx_factorized = std::get<Scalar>(ExpressionSimplifier(yx, { }, nullptr).Factorize());
+
+        CHECK(SimplificationCache::Identical(xy_factorized, yx_factorized));
+        CHECK(Approximately(xy_factorized->Value(), 15.0 * 18.0));
+    }
+}
+
+TEST_CASE("Polynomial") {
+    SUBCASE("Arithmetic collects like terms") {
+        Polynomial x = Polynomial::Variable(0);
+        Polynomial y = Polynomial::Variable(1);
+
+        Polynomial square = x.Add(y).Pow(2);
+
+        CHECK(square.Terms() == 3);
+        CHECK(Approximately(square.Coefficients().at({ { 0, 1 }, { 1, 1 } }), 2.0));
+
+        CHECK(square.Subtract(x.Multiply(x)).Subtract(y.Pow(2)).Subtract(x.Multiply(y).Scale(2.0)).Terms() == 0);
+    }
+
+    SUBCASE("Natural exponents") {
+        CHECK(Polynomial::Natural(3.0));
+        CHECK(Polynomial::Natural(0.0));
+        CHECK(!Polynomial::Natural(-1.0));
+        CHECK(!Polynomial::Natural(0.5));
+        CHECK(!Polynomial::Natural(std::complex<double>(2.0, 1.0)));
+    }
+
+    SUBCASE("Distribute expands powers of sums") {
+        std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+        std::shared_ptr<VariableNode> y(new VariableNode(-1.5));
+        std::shared_ptr<VariableNode> z(new VariableNode(2.0));
+
+        Scalar sum = Scalar(new AdditionNode({ Scalar(new AdditionNode({ Scalar(new AdditionNode({ x, y })), z })), Scalar(new ConstantNode(1.0)) }));
+        Scalar power = Scalar(new ExponentiationNode({ sum, Scalar(new ConstantNode(10.0)) }));
+
+        Scalar expanded = std::get<Scalar>(ExpressionSimplifier(power).Distribute());
+
+        std::function<size_t(Scalar const &)> addends = [&addends](Scalar const &scalar) -> size_t {
+            return scalar->Type() == "AdditionNode" ? addends(scalar->Argument(0)) + addends(scalar->Argument(1)) : 1;
+        };
+
+        // Monomials of degree at most 10 in three variables
+        CHECK(addends(expanded) == 286);
+        CHECK(Approximately(expanded->Value(), std::pow(2.0, 10.0), 1e-6));
+    }
+
+    SUBCASE("Long linear sums are distributed in linear time") {
+        std::shared_ptr<VariableNode> w(new VariableNode(2.0));
+
+        Scalar sum = Scalar(new MultiplicationNode({ w, Scalar(new VariableNode(0.0)) }));
+
+        // w*v_0 + ... + w*v_9999, each atom occurs once so every monomial stays a single pair
+        for (size_t i = 1; i < 10000; ++i) {
+            sum = Scalar(new AdditionNode({ sum, Scalar(new MultiplicationNode({ w, Scalar(new VariableNode(1.0)) })) }));
+        }
+
+        Scalar expanded = std::get<Scalar>(ExpressionSimplifier(sum, { }, nullptr).Distribute());
+
+        CHECK(Approximately(expanded->Value(), 2.0 * 9999.0));
+    }
+
+    SUBCASE("Non-polynomial subtrees are atoms") {
+        std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+
+        Scalar sine = Scalar(new SinNode({ Scalar(new MultiplicationNode({ x, Scalar(new AdditionNode({ x, Scalar(new ConstantNode(1.0)) })) })) }));
+        Scalar product = Scalar(new MultiplicationNode({ Scalar(new AdditionNode({ sine, x })), Scalar(new SubtractionNode({ sine, x })) }));
+
+        Scalar expanded = std::get<Scalar>(ExpressionSimplifier(product).Distribute());
+
+        CHECK(Approximately(expanded->Value(), std::pow(std::sin(0.75), 2.0) - 0.25));
+        CHECK(expanded->Type() == "AdditionNode");
+    }
+}
+
+TEST_CASE("ExpressionSimplifier persistence") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    Scalar sum = Scalar(new AdditionNode({ y, Scalar(new ConstantNode(0.0)) }));
+    Scalar shared = Scalar(new MultiplicationNode({ x, sum }));
+    Scalar scalar = Scalar(new AdditionNode({ shared, Scalar(new SinNode({ shared })) }));
+
+    SUBCASE("Shared subtrees are left untouched") {
+        using Pass = std::variant<Scalar, Matrix> (ExpressionSimplifier::*)();
+
+        for (Pass simplify : std::vector<Pass>({ &ExpressionSimplifier::Simplify, &ExpressionSimplifier::Identify, &ExpressionSimplifier::Distribute, &ExpressionSimplifier::CombineFactors, &ExpressionSimplifier::CombineAddends, &ExpressionSimplifier::Factorize })) {
+            Scalar simplified = std::get<Scalar>((ExpressionSimplifier(scalar).*simplify)());
+
+            CHECK(Approximately(simplified->Value(), 15.0 + std::sin(15.0)));
+            CHECK(scalar->Argument(0) == shared);
+            CHECK(shared->Argument(1) == sum);
+            CHECK(sum->Argument(0) == y);
+        }
+    }
+
+    SUBCASE("Unchanged spines are shared") {
+        Scalar product = Scalar(new MultiplicationNode({ x, y }));
+        Scalar unchanged = Scalar(new AdditionNode({ Scalar(new CosNode({ product })), x }));
+
+        CHECK(std::get<Scalar>(ExpressionSimplifier(unchanged).Identify()) == unchanged);
+
+        Scalar changed = Scalar(new AdditionNode({ Scalar(new CosNode({ Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), product })) })), x }));
+        Scalar identified = std::get<Scalar>(ExpressionSimplifier(changed).Identify());
+
+        CHECK(identified != changed);
+        CHECK(identified->Argument(0)->Argument(0) == product);
+        CHECK(identified->Argument(1) == x);
+        CHECK(changed->Argument(0)->Argument(0)->Type() == "MultiplicationNode");
+        CHECK(changed->Argument(0)->Argument(0)->Argument(1) == product);
+    }
+}
+
+TEST_CASE("SimplificationCache") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    auto make = [&x, &y]() -> Scalar {
+        return Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), x })), Scalar(new ExponentiationNode({ y, Scalar(new ConstantNode(1.0)) })) }));
+    };
+
+    SUBCASE("Repeated subtrees are rewritten once") {
+        std::shared_ptr<SimplificationCache> cache = std::make_shared<SimplificationCache>();
+
+        Scalar first = std::get<Scalar>(ExpressionSimplifier(make(), { }, cache).Identify());
+
+        CHECK(cache->Hits() == 0);
+        CHECK(cache->Size() == 3);
+
+        // A structurally identical tree built from new nodes is answered from the cache
+        Scalar second = std::get<Scalar>(ExpressionSimplifier(make(), { }, cache).Identify());
+
+        CHECK(cache->Hits() == 1);
+        CHECK(second == first);
+        CHECK(Approximately(second->Value(), 8.0));
+
+        // Other variables do not share entries
+        size_t const hits = cache->Hits();
+
+        Scalar other = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), y })), Scalar(new ExponentiationNode({ x, Scalar(new ConstantNode(1.0)) })) }));
+
+        CHECK(std::get<Scalar>(ExpressionSimplifier(other, { }, cache).Identify()) != first);
+        CHECK(cache->Hits() == hits);
+    }
+
+    SUBCASE("Least recently used entries are evicted") {
+        std::shared_ptr<SimplificationCache> cache = std::make_shared<SimplificationCache>(2);
+
+        ExpressionSimplifier(make(), { }, cache).Identify();
+
+        CHECK(cache->Size() == 2);
+        CHECK(cache->Capacity() == 2);
+
+        cache->Clear();
+
+        CHECK(cache->Size() == 0);
+    }
+
+    SUBCASE("Disabled cache") {
+        Scalar scalar = std::get<Scalar>(ExpressionSimplifier(make(), { }, nullptr).Simplify());
+
+        CHECK(Approximately(scalar->Value(), 8.0));
+    }
+
+    SUBCASE("Identical structure") {
+        CHECK(SimplificationCache::Identical(make(), make()));
+        CHECK(!SimplificationCache::Identical(Scalar(new AdditionNode({ x, y })), Scalar(new AdditionNode({ y, x }))));
+        CHECK(!SimplificationCache::Identical(Scalar(new VariableNode(1.0)), Scalar(new VariableNode(1.0))));
+        CHECK(SimplificationCache::Identical(Scalar(new ConstantNode(1.0)), Scalar(new ConstantNode(1.0))));
+    }
+}
+
+TEST_CASE("ExpressionSimplifier::Simplify budgets") {
+    std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+    std::shared_ptr<VariableNode> y(new VariableNode(-1.5));
+    std::shared_ptr<VariableNode> z(new VariableNode(2.0));
+
+    Scalar sum = Scalar(new AdditionNode({ Scalar(new AdditionNode({ Scalar(new AdditionNode({ x, y })), z })), Scalar(new ConstantNode(1.0)) }));
+    Scalar power = Scalar(new ExponentiationNode({ sum, Scalar(new ConstantNode(10.0)) }));
+
+    SUBCASE("Unlimited budget") {
+        ExpressionSimplifier expression_simplifier(Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), x })), { }, nullptr);
+
+        CHECK(std::get<Scalar>(expression_simplifier.Simplify()) == x);
+        CHECK(!expression_simplifier.Truncated());
+    }
+
+    SUBCASE("Rewrite budget") {
+        ExpressionSimplifier expression_simplifier(power, { }, nullptr);
+
+        Scalar simplified = std::get<Scalar>(expression_simplifier.Simplify({ std::chrono::milliseconds::max(), 0, std::numeric_limits<size_t>::max() }));
+
+        CHECK(expression_simplifier.Truncated());
+        CHECK(simplified == power);
+    }
+
+    SUBCASE("Time budget") {
+        ExpressionSimplifier expression_simplifier(power, { }, nullptr);
+
+        Scalar simplified = std::get<Scalar>(expression_simplifier.Simplify({ std::chrono::milliseconds(0), std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max() }));
+
+        CHECK(expression_simplifier.Truncated());
+        CHECK(Approximately(simplified->Value(), 1024.0, 1e-6));
+    }
+
+    SUBCASE("Rewrite budget is shared by parallel elements") {
+        std::vector<Scalar> elements;
+
+        for (size_t i = 0; i < 64; ++i) {
+            elements.push_back(Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), Scalar(new VariableNode(static_cast<double>(i))) })));
+        }
+
+        ExpressionSimplifier expression_simplifier(Matrix(8, 8, elements), { }, nullptr);
+
+        Matrix const simplified = std::get<Matrix>(expression_simplifier.Simplify({ std::chrono::milliseconds::max(), 5, std::numeric_limits<size_t>::max() }));
+
+        size_t rewritten = 0;
+
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                rewritten += simplified(i, j)->Type() == "VariableNode" ? 1 : 0;
+            }
+        }
+
+        // Each participant may finish the rewrite it started before seeing the budget spent
+        CHECK(expression_simplifier.Truncated());
+        CHECK(rewritten <= 5 + ThreadPool::Default().Size());
+    }
+
+    SUBCASE("Node budget keeps the smallest expression") {
+        ExpressionSimplifier expression_simplifier(power, { }, nullptr);
+
+        Scalar simplified = std::get<Scalar>(expression_simplifier.Simplify({ std::chrono::milliseconds::max(), std::numeric_limits<size_t>::max(), 50 }));
+
+        CHECK(expression_simplifier.Truncated());
+        CHECK(simplified->Type() == "ExponentiationNode");
+        CHECK(Approximately(simplified->Value(), 1024.0, 1e-6));
+    }
+}
+
+TEST_CASE("ExpressionSimplifier parallel simplification") {
+    std::shared_ptr<VariableNode> x(new VariableNode(0.5));
+    std::shared_ptr<VariableNode> y(new VariableNode(-1.5));
+
+    std::vector<Scalar> elements;
+
+    for (size_t i = 0; i < 36; ++i) {
+        Scalar constant = Scalar(new ConstantNode(static_cast<double>(i)));
+        Scalar sum = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ constant, x })), y }));
+
+        elements.push_back(Scalar(new AdditionNode({ Scalar(new ExponentiationNode({ sum, Scalar(new ConstantNode(3.0)) })), Scalar(new MultiplicationNode({ x, Scalar(new SubtractionNode({ y, x })) })) })));
+    }
+
+    Matrix matrix(6, 6, elements);
+
+    SUBCASE("Matrix elements match serial simplification") {
+        Matrix simplified = std::get<Matrix>(ExpressionSimplifier(matrix, { }, nullptr).Simplify());
+
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                Scalar scalar = std::get<Scalar>(ExpressionSimplifier(matrix(i, j), { }, nullptr).Simplify());
+
+                CHECK(SimplificationCache::Identical(simplified(i, j), scalar));
+                CHECK(Approximately(simplified.Value(i, j), matrix.Value(i, j), 1e-9));
+            }
+        }
+    }
+
+    SUBCASE("Large independent subtrees") {
+        Scalar lhs = std::reduce(std::cbegin(elements), std::cbegin(elements) + 18, Scalar(new ConstantNode(0.0)), [](Scalar const &lhs, Scalar const &rhs) -> Scalar { return Scalar(new AdditionNode({ lhs, rhs })); });
+        Scalar rhs = std::reduce(std::cbegin(elements) + 18, std::cend(elements), Scalar(new ConstantNode(0.0)), [](Scalar const &lhs, Scalar const &rhs) -> Scalar { return Scalar(new AdditionNode({ lhs, rhs })); });
+
+        Scalar scalar = Scalar(new SinNode({ Scalar(new MultiplicationNode({ lhs, rhs })) }));
+
+        Scalar first = std::get<Scalar>(ExpressionSimplifier(scalar, { }, nullptr).Simplify());
+        Scalar second = std::get<Scalar>(ExpressionSimplifier(scalar, { }, nullptr).Simplify());
+
+        CHECK(SimplificationCache::Identical(first, second));
+        CHECK(Approximately(first->Value(), scalar->Value(), 1e-6));
+    }
+
+    SUBCASE("Earlier elements do not change later ones") {
+        std::shared_ptr<VariableNode> a(new VariableNode(7.0));
+        std::shared_ptr<VariableNode> b(new VariableNode(11.0));
+
+        // y + b meets y and b before x, which used to reorder the common factors of the second element
+        Scalar sum = Scalar(new AdditionNode({ y, b }));
+        Scalar product = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, y })), a })), Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ x, y })), b })) }));
+
+        Scalar alone = std::get<Scalar>(ExpressionSimplifier(product, { }, nullptr).Simplify());
+
+        for (Matrix const &mixed : { Matrix(1, 2, { sum, product }), Matrix(1, 2, { product, sum }) }) {
+            Matrix const simplified = std::get<Matrix>(ExpressionSimplifier(mixed, { }, nullptr).Simplify());
+
+            CHECK(SimplificationCache::Identical(simplified(0, mixed(0, 0) == product ? 0 : 1), alone));
+        }
+
+        // The shared cache keeps whichever shape was inserted first, which is now the same shape
+        std::shared_ptr<SimplificationCache> cache = std::make_shared<SimplificationCache>();
+
+        ExpressionSimplifier(Matrix(1, 2, { sum, product }), { }, cache).Simplify();
+
+        CHECK(SimplificationCache::Identical(std::get<Scalar>(ExpressionSimplifier(product, { }, cache).Simplify()), alone));
+    }
+}
+
+TEST_CASE("SimplificationStatistics") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+
+    Scalar scalar = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ Scalar(new ConstantNode(1.0)), x })), Scalar(new SubtractionNode({ x, Scalar(new ConstantNode(0.0)) })) }));
+
+    SUBCASE("Passes and rules are recorded") {
+        std::shared_ptr<SimplificationStatistics> statistics = std::make_shared<SimplificationStatistics>();
+
+        ExpressionSimplifier expression_simplifier(scalar, { }, nullptr);
+
+        expression_simplifier.Instrument(statistics);
+        expression_simplifier.Simplify();
+
+        CHECK(statistics->passes.size() == 5);
+        CHECK(statistics->passes.at("Identify").calls == 4);
+        CHECK(statistics->passes.at("Distribute").calls == 1);
+        CHECK(statistics->passes.at("Distribute").nodes_in == 6);
+        CHECK(statistics->cache_hits == 0);
+
+        ExpressionSimplifier identifier(scalar, { }, nullptr);
+
+        identifier.Instrument(statistics);
+        identifier.Identify();
+
+        CHECK(statistics->passes.at("Identify").calls == 5);
+        CHECK(statistics->rules.at("mul-one") == 1);
+        CHECK(statistics->rules.at("sub-zero") == 1);
+    }
+
+    SUBCASE("JSON") {
+        SimplificationStatistics statistics;
+
+        statistics.Record("Identify", 6, 3, std::chrono::microseconds(1500));
+        statistics.rules["mul-one"] = 2;
+        statistics.cache_hits = 1;
+
+        CHECK(statistics.Json() == "{\"passes\":{\"Identify\":{\"calls\":1,\"nodes_in\":6,\"nodes_out\":3,\"milliseconds\":1.500}},\"rules\":{\"mul-one\":2},\"cache_hits\":1,\"cache_misses\":0}");
+    }
+
+    SUBCASE("Disabled") {
+        ExpressionSimplifier expression_simplifier(scalar, { }, nullptr);
+
+        CHECK(Approximately(std::get<Scalar>(expression_simplifier.Simplify())->Value(), 6.0));
+    }
+}
+
+TEST_CASE("ExpressionEliminator") {
+    std::shared_ptr<VariableNode> x(new VariableNode(3.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(5.0));
+
+    // sin(x*y) * (x*y) + (y*x) / sin(x*y)
+    Scalar scalar = Scalar(new AdditionNode({
+        Scalar(new MultiplicationNode({ Scalar(new SinNode({ Scalar(new MultiplicationNode({ x, y })) })), Scalar(new MultiplicationNode({ x, y })) })),
+        Scalar(new DivisionNode({ Scalar(new MultiplicationNode({ y, x })), Scalar(new SinNode({ Scalar(new MultiplicationNode({ x, y })) })) }))
+    }));
+
+    SUBCASE("Identical subtrees are merged into one node") {
+        Scalar eliminated = std::get<Scalar>(ExpressionEliminator(scalar).Eliminate());
+
+        Scalar product = eliminated->Argument(0)->Argument(1);
+
+        CHECK(eliminated->Argument(0)->Argument(0)->Argument(0) == product);
+        CHECK(eliminated->Argument(1)->Argument(0) == product);
+        CHECK(eliminated->Argument(1)->Argument(1) == eliminated->Argument(0)->Argument(0));
+        CHECK(Approximately(eliminated->Value(), scalar->Value()));
+    }
+
+    SUBCASE("Shared subtrees are bound to temporaries once") {
+        ExpressionEliminator::Let let = ExpressionEliminator(scalar).Bind();
+
+        // t_{0} = x*y, t_{1} = sin(t_{0})
+        REQUIRE(let.bindings.size() == 2);
+        CHECK(let.bindings[0].definition->Type() == "MultiplicationNode");
+        CHECK(let.bindings[1].definition->Argument(0) == let.bindings[0].temporary);
+
+        CHECK(Approximately(std::get<std::complex<double>>(let.Evaluate()), scalar->Value()));
+
+        // Temporaries follow their inputs on the next evaluation
+        *x = 2.0;
+
+        CHECK(Approximately(std::get<std::complex<double>>(let.Evaluate()), scalar->Value()));
+    }
+
+    SUBCASE("Temporaries of unchanged variables are kept") {
+        // t_{0} = sin(y) only depends on y, so changing x leaves it alone
+        Scalar sin_y = Scalar(new SinNode({ y }));
+        Scalar shared = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ sin_y, x })), Scalar(new ExponentiationNode({ sin_y, x })) }));
+
+        ExpressionEliminator::Let let = ExpressionEliminator(shared).Bind();
+
+        REQUIRE(let.bindings.size() == 1);
+
+        let.Evaluate();
+
+        *let.bindings[0].temporary = 100.0;
+        *x = 2.0;
+
+        CHECK(Approximately(std::get<std::complex<double>>(let.Evaluate({ x })), 100.0 * 2.0 + 100.0 * 100.0));
+
+        CHECK(Approximately(std::get<std::complex<double>>(let.Evaluate({ y })), shared->Value()));
+    }
+
+    SUBCASE("Matrix elements share temporaries") {
+        Scalar product = Scalar(new MultiplicationNode({ x, y }));
+
+        Matrix matrix(1, 2, { Scalar(new SinNode({ product })), Scalar(new CosNode({ Scalar(new MultiplicationNode({ x, y })) })) });
+
+        ExpressionEliminator::Let let = ExpressionEliminator(matrix).Bind();
+
+        CHECK(let.bindings.size() == 1);
+        CHECK(Approximately(std::get<NumericMatrix>(let.Evaluate())(0, 1), std::cos(15.0)));
+
+        std::string const composed = ExpressionEliminator(scalar, { { "x", x }, { "y", y } }).Compose();
+
+        CHECK(composed.find("t_{0}=x*y\\\\") == 0);
+        CHECK(composed.find("t_{1}=sin\\left(t_{0}\\right)\\\\") != std::string::npos);
+    }
+}
+
+TEST_CASE("Calculus::Partial") {
+    std::shared_ptr<VariableNode> x(new VariableNode(1.0));
+    std::shared_ptr<VariableNode> y(new VariableNode(2.0));
+
+    SUBCASE("Shared subtrees are differentiated once") {
+        // x^{2^{40}} as forty nested products of one shared node
+        Scalar scalar = x;
+
+        for (size_t i = 0; i < 40; ++i) {
+            scalar = Scalar(new MultiplicationNode({ scalar, scalar }));
+        }
+
+        Scalar partial = Calculus(scalar, { }).Partial(x);
+
+        // The derivative is a DAG of the same depth, so it is evaluated through its temporaries
+        ExpressionEliminator::Let let = ExpressionEliminator(partial).Bind();
+
+        CHECK(let.bindings.size() <= 4 * 40);
+        CHECK(Approximately(std::get<std::complex<double>>(let.Evaluate()), std::pow(2.0, 40.0)));
+    }
+
+    SUBCASE("Repeated partials share their derivatives") {
+        Scalar scalar = Scalar(new MultiplicationNode({ Scalar(new SinNode({ x })), y }));
+
+        Calculus calculus(scalar, { });
+
+        Scalar partial = calculus.Partial(x);
+
+        CHECK(calculus.Partial(x) == partial);
+        CHECK(calculus.Partial(y) != partial);
+        CHECK(Approximately(partial->Value(), std::cos(1.0) * 2.0));
+    }
+
+    SUBCASE("Independent subtrees are not descended into") {
+        // d/dx { sin(y) * x + cos(y) } = sin(y)
+        Scalar sin_y = Scalar(new SinNode({ y }));
+        Scalar scalar = Scalar(new AdditionNode({ Scalar(new MultiplicationNode({ sin_y, x })), Scalar(new CosNode({ y })) }));
+
+        Scalar partial = Calculus(scalar, { }).Partial(x);
+
+        // The product rule keeps only the term of the dependent factor
+        CHECK(partial->Type() == "MultiplicationNode");
+        CHECK(partial->Argument(1) == sin_y);
+        CHECK(Approximately(partial->Value(), std::sin(2.0)));
+    }
+
+    SUBCASE("Long sums of distinct variables") {
+        std::vector<std::shared_ptr<VariableNode>> variables;
+
+        Scalar scalar = Scalar(new ConstantNode(0.0));
+
+        for (size_t i = 0; i < 10000; ++i) {
+            variables.emplace_back(new VariableNode(static_cast<double>(i)));
+
+            scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ variables.back(), variables.back() })) }));
+        }
+
+        Calculus calculus(scalar, { });
+
+        CHECK(Approximately(calculus.Partial(variables.front())->Value(), 0.0));
+        CHECK(Approximately(calculus.Partial(variables.back())->Value(), 2.0 * 9999.0));
+    }
+
+    SUBCASE("Powers are differentiated without exp and ln") {
+        auto contains = [](Scalar const &scalar, std::string const &type) -> bool {
+            std::function<bool(Scalar const &)> search = [&search, &type](Scalar const &node) -> bool {
+                return node->Type() == type || std::any_of(std::cbegin(node->Arguments()), std::cend(node->Arguments()), search);
+            };
+
+            return search(scalar);
+        };
+
+        // d/dx { x^3 } = 3 * x^2
+        Scalar power = Calculus(Scalar(new ExponentiationNode({ x, Scalar(new ConstantNode(3.0)) })), { }).Partial(x);
+
+        *x = 0.0;
+
+        CHECK(!contains(power, "ExpNode"));
+        CHECK(!contains(power, "LnNode"));
+        CHECK(Approximately(power->Value(), 0.0));
+
+        *x = 2.0;
+
+        CHECK(Approximately(power->Value(), 12.0));
+
+        // d/dx { y^x } = y^x * ln(y)
+        Scalar exponential = Calculus(Scalar(new ExponentiationNode({ y, x })), { }).Partial(x);
+
+        CHECK(!contains(exponential, "ExpNode"));
+        CHECK(Approximately(exponential->Value(), 4.0 * std::log(2.0)));
+
+        // d/dx { x^x } = x^x * { ln(x) + 1 }
+        Scalar general = Calculus(Scalar(new ExponentiationNode({ x, x })), { }).Partial(x);
+
+        CHECK(!contains(general, "ExpNode"));
+        CHECK(Approximately(general->Value(), 4.0 * (std::log(2.0) + 1.0)));
+    }
+}
+
+TEST_CASE("Calculus::Jacobian and Calculus::Hessian") {
+    std::vector<Scalar> variables;
+
+    for (size_t i = 0; i < 24; ++i) {
+        variables.push_back(Scalar(new VariableNode(0.1 * (i + 1))));
+    }
+
+    // f = x_0 * x_1 + x_1 * x_2 + ... + x_22 * x_23 + sin(x_0)
+    Scalar scalar = Scalar(new SinNode({ variables[0] }));
+
+    for (size_t i = 0; i + 1 < variables.size(); ++i) {
+        scalar = Scalar(new AdditionNode({ scalar, Scalar(new MultiplicationNode({ variables[i], variables[i + 1] })) }));
+    }
+
+    SUBCASE("Jacobian of a Scalar is its gradient as a row") {
+        Matrix jacobian = Calculus(scalar, { }).Jacobian(variables);
+
+        REQUIRE(jacobian.Rows() == 1);
+        REQUIRE(jacobian.Cols() == variables.size());
+
+        CHECK(Approximately(jacobian(0, 0)->Value(), std::cos(0.1) + 0.2));
+        CHECK(Approximately(jacobian(0, 5)->Value(), 0.5 + 0.7));
+        CHECK(Approximately(jacobian(0, 23)->Value(), 2.3));
+    }
+
+    SUBCASE("Jacobian of a Matrix has a row per element") {
+        Matrix matrix(2, 1, { Scalar(new MultiplicationNode({ variables[0], variables[1] })), Scalar(new ExponentiationNode({ variables[1], Scalar(new ConstantNode(2.0)) })) });
+
+        Matrix jacobian = Calculus(matrix, { }).Jacobian({ variables[0], variables[1] });
+
+        REQUIRE(jacobian.Rows() == 2);
+        REQUIRE(jacobian.Cols() == 2);
+
+        CHECK(Approximately(jacobian(0, 0)->Value(), 0.2));
+        CHECK(Approximately(jacobian(0, 1)->Value(), 0.1));
+        CHECK(Approximately(jacobian(1, 0)->Value(), 0.0));
+        CHECK(Approximately(jacobian(1, 1)->Value(), 0.4));
+    }
+
+    SUBCASE("Hessian is symmetric and shares its mirrored entries") {
+        Matrix hessian = Calculus(scalar, { }).Hessian(variables);
+
+        REQUIRE(hessian.Rows() == variables.size());
+        REQUIRE(hessian.Cols() == variables.size());
+
+        CHECK(Approximately(hessian(0, 0)->Value(), -std::sin(0.1)));
+
+        for (size_t i = 0; i < variables.size(); ++i) {
+            for (size_t j = 0; j < variables.size(); ++j) {
+                CHECK(hessian(i, j) == hessian(j, i));
+                CHECK(Approximately(hessian(i, j)->Value(), (i + 1 == j || j + 1 == i) ? 1.0 : (i == 0 && j == 0 ? -std::sin(0.1) : 0.0)));
+            }
+        }
+    }
+
+    SUBCASE("Variables must be distinct") {
+        CHECK_THROWS_AS(Calculus(scalar, { }).Hessian({ variables[0], variables[0] }), std::invalid_argument);
+    }
+}
@@ -21,6 +21,70 @@ Scalar Calculus::Partial(std::variant<Scalar, Matrix> const &node_variant, Scala
 
     Scalar scalar = std::get<Scalar>(node_variant);
 
+    // d/dx { f(y) } = 0, without building the derivative of every node beneath it
+    if (with_respect_to_ptr->Type() == "VariableNode" && !Depends(scalar, with_respect_to_ptr)) {
+        return std::shared_ptr<ConstantNode>(new ConstantNode(0.0));
+    }
+
+    auto variable_it = m_derivatives.find(with_respect_to_ptr);
+
+    // Parallel callers prepare every variable first, so that they only ever find
+    if (variable_it == std::end(m_derivatives)) {
+        variable_it = m_derivatives.emplace(with_respect_to_ptr, std::unordered_map<Scalar, Scalar>()).first;
+    }
+
+    std::unordered_map<Scalar, Scalar> &derivatives = variable_it->second;
+
+    auto derivative_it = derivatives.find(scalar);
+
+    if (derivative_it != std::end(derivatives)) {
+        return derivative_it->second;
+    }
+
+    // The derivative of a shared subtree is shared as well, which keeps the output linear in the size of the input
+    Scalar derivative = Differentiate(scalar, with_respect_to_ptr);
+
+    derivatives.emplace(scalar, derivative);
+
+    return derivative;
+}
+
+bool Calculus::Depends(Scalar const &scalar, Scalar const &with_respect_to_ptr)
+{
+    if (scalar == with_respect_to_ptr) {
+        return true;
+    }
+    else if (scalar->Arguments().empty()) {
+        return false;
+    }
+
+    auto variable_it = m_dependencies.find(with_respect_to_ptr);
+
+    // Parallel callers prepare every variable first, so that they only ever find
+    if (variable_it == std::end(m_dependencies)) {
+        variable_it = m_dependencies.emplace(with_respect_to_ptr, std::unordered_map<Scalar, bool>()).first;
+    }
+
+    std::unordered_map<Scalar, bool> &dependencies = variable_it->second;
+
+    auto dependency_it = dependencies.find(scalar);
+
+    if (dependency_it != std::end(dependencies)) {
+        return dependency_it->second;
+    }
+
+    // Each node is descended into once per variable, so shared subtrees are not walked again
+    bool const depends = std::any_of(std::cbegin(scalar->Arguments()), std::cend(scalar->Arguments()), [this, &with_respect_to_ptr](Scalar const &argument) -> bool {
+        return Depends(argument, with_respect_to_ptr);
+    });
+
+    dependencies.emplace(scalar, depends);
+
+    return depends;
+}
+
+Scalar Calculus::Differentiate(Scalar const &scalar, Scalar const &with_respect_to_ptr)
+{
     // d/dx { x } = 1
     if (Node::Equivalent(scalar, with_respect_to_ptr)) {
         return std::shared_ptr<ConstantNode>(new ConstantNode(1.0));
@@ -35,41 +99,72 @@ Scalar Calculus::Partial(std::variant<Scalar, Matrix> const &node_variant, Scala
     }
     // d/dx { f(x) + g(x) } = f'(x) + g'(x)
     else if (scalar->Type() == "AdditionNode") {
-        return std::shared_ptr<AdditionNode>(new AdditionNode({
-            Partial(scalar->Argument(0), with_respect_to_ptr),
-            Partial(scalar->Argument(1), with_respect_to_ptr)
-        }));
+        Scalar lhs_partial = Partial(scalar->Argument(0), with_respect_to_ptr);
+        Scalar rhs_partial = Partial(scalar->Argument(1), with_respect_to_ptr);
+
+        // Terms of independent arguments are left out instead of being built around a zero
+        if (Node::Zero(lhs_partial)) {
+            return rhs_partial;
+        }
+        else if (Node::Zero(rhs_partial)) {
+            return lhs_partial;
+        }
+
+        return std::shared_ptr<AdditionNode>(new AdditionNode({ lhs_partial, rhs_partial }));
     }
     // d/dx { f(x) - g(x) } = f'(x) - g'(x)
     else if (scalar->Type() == "SubtractionNode") {
-        return std::shared_ptr<SubtractionNode>(new SubtractionNode({
-            Partial(scalar->Argument(0), with_respect_to_ptr),
-            Partial(scalar->Argument(1), with_respect_to_ptr)
-        }));
+        Scalar lhs_partial = Partial(scalar->Argument(0), with_respect_to_ptr);
+        Scalar rhs_partial = Partial(scalar->Argument(1), with_respect_to_ptr);
+
+        if (Node::Zero(rhs_partial)) {
+            return lhs_partial;
+        }
+
+        return std::shared_ptr<SubtractionNode>(new SubtractionNode({ lhs_partial, rhs_partial }));
     }
     // d/dx { f(x) * g(x) } = f'(x) * g(x) + g'(x) * f(x)
     else if (scalar->Type() == "MultiplicationNode") {
+        Scalar lhs_partial = Partial(scalar->Argument(0), with_respect_to_ptr);
+        Scalar rhs_partial = Partial(scalar->Argument(1), with_respect_to_ptr);
+
+        // d/dx { 2 * f(x) } = f'(x) * 2
+        if (Node::Zero(lhs_partial)) {
+            return std::shared_ptr<MultiplicationNode>(new MultiplicationNode({ rhs_partial, scalar->Argument(0) }));
+        }
+        else if (Node::Zero(rhs_partial)) {
+            return std::shared_ptr<MultiplicationNode>(new MultiplicationNode({ lhs_partial, scalar->Argument(1) }));
+        }
+
         return std::shared_ptr<AdditionNode>(new AdditionNode({
             std::shared_ptr<MultiplicationNode>(new MultiplicationNode({ 
-                Partial(scalar->Argument(0), with_respect_to_ptr),
+                lhs_partial,
                 scalar->Argument(1)
             })),
             std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
-                Partial(scalar->Argument(1), with_respect_to_ptr),
+                rhs_partial,
                 scalar->Argument(0)
             }))
         }));
     }
     // d/dx { f(x) / g(x) } = { f'(x) * g(x) - g'(x) * f(x) } / { g(x) }^2
     else if (scalar->Type() == "DivisionNode") {
+        Scalar lhs_partial = Partial(scalar->Argument(0), with_respect_to_ptr);
+        Scalar rhs_partial = Partial(scalar->Argument(1), with_respect_to_ptr);
+
+        // d/dx { f(x) / 2 } = f'(x) / 2
+        if (Node::Zero(rhs_partial)) {
+            return std::shared_ptr<DivisionNode>(new DivisionNode({ lhs_partial, scalar->Argument(1) }));
+        }
+
         return std::shared_ptr<DivisionNode>(new DivisionNode({
             std::shared_ptr<SubtractionNode>(new SubtractionNode({
                 std::shared_ptr<MultiplicationNode>(new MultiplicationNode({ 
-                    Partial(scalar->Argument(0), with_respect_to_ptr),
+                    lhs_partial,
                     scalar->Argument(1)
                 })),
                 std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
-                    Partial(scalar->Argument(1), with_respect_to_ptr),
+                    rhs_partial,
                     scalar->Argument(0)
                 }))
             })),
@@ -79,14 +174,57 @@ Scalar Calculus::Partial(std::variant<Scalar, Matrix> const &node_variant, Scala
             }))
         }));
     }
-    // d/dx { x^2 } = d/dx { e^{ ln(x) * 2 } } = e^{ ln(x) * 2 } * d/dx { ln(x) * 2 } = 2 * x^2 * x^{-1} = 2 * x
+    // The exp(ln) form is only needed when both base and exponent vary, it is larger, slower to evaluate and undefined at a base of 0
     else if (scalar->Type() == "ExponentiationNode") {
-        return Partial(std::shared_ptr<ExpNode>(new ExpNode({
-                std::shared_ptr<MultiplicationNode>(new MultiplicationNode({ 
-                    std::shared_ptr<LnNode>(new LnNode({ scalar->Argument(0) })),
-                    scalar->Argument(1)
+        Scalar base_partial = Partial(scalar->Argument(0), with_respect_to_ptr);
+        Scalar exponent_partial = Partial(scalar->Argument(1), with_respect_to_ptr);
+
+        if (Node::Zero(base_partial) && Node::Zero(exponent_partial)) {
+            return std::shared_ptr<ConstantNode>(new ConstantNode(0.0));
+        }
+        // d/dx { x^3 } = 3 * x^2 * d/dx { x }
+        else if (Node::Zero(exponent_partial)) {
+            Scalar exponent = scalar->Argument(1)->Type() == "ConstantNode" ? 
+                Scalar(new ConstantNode(scalar->Argument(1)->Value() - 1.0)) : 
+                Scalar(new SubtractionNode({ scalar->Argument(1), std::shared_ptr<ConstantNode>(new ConstantNode(1.0)) }));
+
+            return std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                    scalar->Argument(1),
+                    std::shared_ptr<ExponentiationNode>(new ExponentiationNode({ scalar->Argument(0), exponent }))
+                })),
+                base_partial
+            }));
+        }
+        // d/dx { 2^x } = 2^x * ln(2) * d/dx { x }
+        else if (Node::Zero(base_partial)) {
+            return std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                    scalar,
+                    std::shared_ptr<LnNode>(new LnNode({ scalar->Argument(0) }))
+                })),
+                exponent_partial
+            }));
+        }
+        // d/dx { f(x)^g(x) } = f(x)^g(x) * { g'(x) * ln(f(x)) + g(x) * f'(x) / f(x) }
+        else {
+            return std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                scalar,
+                std::shared_ptr<AdditionNode>(new AdditionNode({
+                    std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                        exponent_partial,
+                        std::shared_ptr<LnNode>(new LnNode({ scalar->Argument(0) }))
+                    })),
+                    std::shared_ptr<DivisionNode>(new DivisionNode({
+                        std::shared_ptr<MultiplicationNode>(new MultiplicationNode({
+                            scalar->Argument(1),
+                            base_partial
+                        })),
+                        scalar->Argument(0)
+                    }))
                 }))
-            })), with_respect_to_ptr);
+            }));
+        }
     }
     // d/dx { e^{ x^2 } } = e^{ x^2 } * d/dx { x^2 } = e^{ x^2 } * 2 * x
     else if (scalar->Type() == "ExpNode") {
@@ -202,3 +340,95 @@ Matrix Calculus::Curl(std::variant<Scalar, Matrix> const &node_variant, Scalar c
 
     return curl_matrix;
 }
+
+Matrix Calculus::Jacobian(std::vector<Scalar> const &variables)
+{
+    return Jacobian(m_node_variant, variables);
+}
+
+Matrix Calculus::Jacobian(std::variant<Scalar, Matrix> const &node_variant, std::vector<Scalar> const &variables)
+{
+    std::vector<Scalar> functions;
+
+    // A matrix is read row by row, so an m x k matrix gives an { m * k } x n Jacobian
+    if (std::holds_alternative<Matrix>(node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(node_variant);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                functions.push_back(matrix(i, j));
+            }
+        }
+    }
+    else if (std::holds_alternative<Scalar>(node_variant)) {
+        functions.push_back(std::get<Scalar>(node_variant));
+    }
+
+    Prepare(variables);
+
+    std::vector<Scalar> elements(functions.size() * variables.size());
+
+    // Each column is differentiated by one participant, which then owns the derivatives of its variable
+    ThreadPool::Default().ParallelFor(variables.size(), [this, &functions, &variables, &elements](size_t const &begin, size_t const &end) {
+        for (size_t j = begin; j < end; ++j) {
+            for (size_t i = 0; i < functions.size(); ++i) {
+                elements[i * variables.size() + j] = Partial(functions[i], variables[j]);
+            }
+        }
+    });
+
+    return Matrix(functions.size(), variables.size(), elements);
+}
+
+Matrix Calculus::Hessian(std::vector<Scalar> const &variables)
+{
+    return Hessian(m_node_variant, variables);
+}
+
+Matrix Calculus::Hessian(std::variant<Scalar, Matrix> const &node_variant, std::vector<Scalar> const &variables)
+{
+    if (!std::holds_alternative<Scalar>(node_variant)) {
+        throw std::invalid_argument("Hessian only defined for Scalar");
+    }
+
+    Scalar scalar = std::get<Scalar>(node_variant);
+
+    Prepare(variables);
+
+    std::vector<Scalar> gradient(variables.size());
+
+    ThreadPool::Default().ParallelFor(variables.size(), [this, &scalar, &variables, &gradient](size_t const &begin, size_t const &end) {
+        for (size_t j = begin; j < end; ++j) {
+            gradient[j] = Partial(scalar, variables[j]);
+        }
+    });
+
+    std::vector<Scalar> elements(variables.size() * variables.size());
+
+    // The first derivatives are differentiated again, and only the upper triangle since d/dy { d/dx { f } } = d/dx { d/dy { f } }
+    ThreadPool::Default().ParallelFor(variables.size(), [this, &variables, &gradient, &elements](size_t const &begin, size_t const &end) {
+        for (size_t j = begin; j < end; ++j) {
+            for (size_t i = 0; i <= j; ++i) {
+                elements[i * variables.size() + j] = Partial(gradient[i], variables[j]);
+                elements[j * variables.size() + i] = elements[i * variables.size() + j];
+            }
+        }
+    });
+
+    return Matrix(variables.size(), variables.size(), elements);
+}
+
+void Calculus::Prepare(std::vector<Scalar> const &variables)
+{
+    std::set<Scalar> distinct(std::cbegin(variables), std::cend(variables));
+
+    // Two participants must never differentiate with respect to the same variable
+    if (distinct.size() != variables.size()) {
+        throw std::invalid_argument("Variables must be distinct");
+    }
+
+    for (Scalar const &variable : variables) {
+        m_derivatives.emplace(variable, std::unordered_map<Scalar, Scalar>());
+        m_dependencies.emplace(variable, std::unordered_map<Scalar, bool>());
+    }
+}
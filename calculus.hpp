@@ -8,6 +8,7 @@
 #include <string>
 #include <set>
 #include <vector>
+#include <unordered_map>
 #include <algorithm>
 #include <numeric>
 #include <functional>
@@ -17,11 +18,18 @@
 #include "functions.hpp"
 #include "utils.hpp"
 #include "expression_visualizer.hpp"
+#include "thread_pool.hpp"
 
 class Calculus
 {
     std::variant<Scalar, Matrix> m_node_variant;
     std::map<std::string, std::variant<Scalar, Matrix>> m_node_map;
+
+    // Derivatives are remembered per variable and node for the lifetime of the instance, so shared subtrees and repeated partials are differentiated once
+    std::unordered_map<Scalar, std::unordered_map<Scalar, Scalar>> m_derivatives;
+
+    // Whether a node depends on a variable is only worked out when it is first asked, and remembered per variable the same way
+    std::unordered_map<Scalar, std::unordered_map<Scalar, bool>> m_dependencies;
     
 public: 
     Calculus(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map);
@@ -30,10 +38,18 @@ public:
     Matrix Gradient(Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
     Scalar Divergence(Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
     Matrix Curl(Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
+    Matrix Jacobian(std::vector<Scalar> const &variables);
+    Matrix Hessian(std::vector<Scalar> const &variables);
 
 private:
     Scalar Partial(std::variant<Scalar, Matrix> const &node_variant, Scalar const &with_respect_to_ptr);
+    Scalar Differentiate(Scalar const &scalar, Scalar const &with_respect_to_ptr);
+    bool Depends(Scalar const &scalar, Scalar const &with_respect_to_ptr);
     Matrix Gradient(std::variant<Scalar, Matrix> const &node_variant, Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
     Scalar Divergence(std::variant<Scalar, Matrix> const &node_variant, Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
     Matrix Curl(std::variant<Scalar, Matrix> const &node_variant, Scalar const &with_respect_to_11_ptr, Scalar const &with_respect_to_21_ptr, Scalar const &with_respect_to_31_ptr);
+    Matrix Jacobian(std::variant<Scalar, Matrix> const &node_variant, std::vector<Scalar> const &variables);
+    Matrix Hessian(std::variant<Scalar, Matrix> const &node_variant, std::vector<Scalar> const &variables);
+
+    void Prepare(std::vector<Scalar> const &variables);
 };
@@ -0,0 +1,700 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "e_graph.hpp"
+
+bool EGraph::ENode::operator==(ENode const &other) const
+{
+    return type == other.type && children == other.children && leaf == other.leaf && value == other.value;
+}
+
+size_t EGraph::ENodeHash::operator()(ENode const &node) const
+{
+    size_t hash = std::hash<std::string>()(node.type);
+
+    auto combine = [&hash](size_t const &value) {
+        hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    };
+
+    for (Id const &child : node.children) {
+        combine(std::hash<Id>()(child));
+    }
+
+    combine(std::hash<size_t>()(node.leaf));
+    combine(std::hash<double>()(node.value.real()));
+    combine(std::hash<double>()(node.value.imag()));
+
+    return hash;
+}
+
+EGraph::EGraph() : m_node_count(0)
+{
+}
+
+EGraph::Id EGraph::Add(Scalar const &scalar)
+{
+    std::unordered_map<Node const *, Id> added;
+
+    return Add(scalar, added);
+}
+
+EGraph::Id EGraph::Add(Scalar const &scalar, std::unordered_map<Node const *, Id> &added)
+{
+    auto added_it = added.find(scalar.get());
+
+    // A node shared by several parents is added once instead of once per path to it
+    if (added_it != std::end(added)) {
+        return Find(added_it->second);
+    }
+
+    Id id;
+
+    if (scalar->Type() == "ConstantNode") {
+        id = Add(ENode{ "ConstantNode", { }, 0, scalar->Value() });
+    }
+    else if (scalar->Arguments().empty()) {
+        auto leaf_it = std::find(std::cbegin(m_leaves), std::cend(m_leaves), scalar);
+
+        if (leaf_it == std::cend(m_leaves)) {
+            leaf_it = m_leaves.insert(std::cend(m_leaves), scalar);
+        }
+
+        id = Add(ENode{ scalar->Type(), { }, static_cast<size_t>(std::distance(std::cbegin(m_leaves), leaf_it)), 0.0 });
+    }
+    else {
+        ENode node{ scalar->Type(), { }, 0, 0.0 };
+
+        for (Scalar const &argument : scalar->Arguments()) {
+            node.children.push_back(Add(argument, added));
+        }
+
+        id = Add(node);
+    }
+
+    added.emplace(scalar.get(), id);
+
+    return id;
+}
+
+EGraph::Id EGraph::Find(Id id) const
+{
+    while (m_union_find[id] != id) {
+        id = m_union_find[id];
+    }
+
+    return id;
+}
+
+bool EGraph::Saturate(std::chrono::milliseconds const &time_budget, size_t const &node_budget, size_t const &iteration_budget)
+{
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+    auto exhausted = [this, &start, &time_budget, &node_budget]() -> bool {
+        return std::chrono::steady_clock::now() - start > time_budget || m_node_count > node_budget;
+    };
+
+    for (size_t iteration = 0; iteration < iteration_budget; ++iteration) {
+        std::vector<std::tuple<Rule const *, Id, Substitution>> matches;
+
+        // Every rule is matched against the same graph before any of them is applied, so the result does not depend on rule order
+        for (Rule const &rule : Rules()) {
+            for (Id id = 0; id < m_classes.size(); ++id) {
+                if (Find(id) != id) {
+                    continue;
+                }
+
+                std::vector<Substitution> substitutions;
+
+                Match(rule.lhs, id, { }, substitutions);
+
+                for (Substitution const &substitution : substitutions) {
+                    matches.emplace_back(&rule, id, substitution);
+                }
+            }
+
+            if (exhausted()) {
+                return false;
+            }
+        }
+
+        size_t const node_count = m_node_count;
+        bool changed = false;
+
+        for (auto const &[rule, id, substitution] : matches) {
+            changed |= Union(id, Instantiate(rule->rhs, substitution));
+
+            if (exhausted()) {
+                Rebuild();
+
+                return false;
+            }
+        }
+
+        Rebuild();
+
+        if (!changed && m_node_count == node_count) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Scalar EGraph::Extract(Id const &id) const
+{
+    size_t const unreachable = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> costs(m_classes.size(), unreachable);
+    std::vector<ENode const *> best(m_classes.size(), nullptr);
+
+    // Costs are relaxed until they settle, the cheapest node of a class is the one with the smallest tree
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (Id class_id = 0; class_id < m_classes.size(); ++class_id) {
+            if (Find(class_id) != class_id) {
+                continue;
+            }
+
+            for (ENode const &node : m_classes[class_id].nodes) {
+                size_t cost = 1;
+
+                for (Id const &child : node.children) {
+                    size_t const child_cost = costs[Find(child)];
+
+                    if (child_cost == unreachable) {
+                        cost = unreachable;
+
+                        break;
+                    }
+
+                    // Tree sizes of shared classes grow exponentially with depth, so they saturate just below unreachable
+                    cost = child_cost < unreachable - 1 - cost ? cost + child_cost : unreachable - 1;
+                }
+
+                if (cost < costs[class_id]) {
+                    costs[class_id] = cost;
+                    best[class_id] = &node;
+
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    std::vector<Scalar> built(m_classes.size());
+
+    // Each class is built once, so a class reached along several paths yields one shared node instead of an unfolded tree
+    std::function<Scalar(Id const &)> build = [this, &best, &built, &build](Id const &class_id) -> Scalar {
+        Id const canonical_id = Find(class_id);
+
+        if (built[canonical_id]) {
+            return built[canonical_id];
+        }
+
+        ENode const &node = *best[canonical_id];
+
+        if (node.type == "ConstantNode") {
+            built[canonical_id] = Scalar(new ConstantNode(node.value));
+        }
+        else if (node.children.empty()) {
+            built[canonical_id] = m_leaves[node.leaf];
+        }
+        else {
+            std::vector<Scalar> arguments;
+
+            for (Id const &child : node.children) {
+                arguments.push_back(build(child));
+            }
+
+            built[canonical_id] = Construct(node.type, arguments);
+        }
+
+        return built[canonical_id];
+    };
+
+    return build(id);
+}
+
+size_t EGraph::Classes() const
+{
+    size_t classes = 0;
+
+    for (Id id = 0; id < m_classes.size(); ++id) {
+        if (Find(id) == id) {
+            ++classes;
+        }
+    }
+
+    return classes;
+}
+
+size_t EGraph::Nodes() const
+{
+    return m_node_count;
+}
+
+EGraph::Id EGraph::Add(ENode node)
+{
+    node = Canonicalize(node);
+
+    auto memo_it = m_memo.find(node);
+
+    if (memo_it != std::end(m_memo)) {
+        return Find(memo_it->second);
+    }
+
+    Id const id = m_classes.size();
+
+    m_union_find.push_back(id);
+    m_classes.push_back({ { node }, node.type == "ConstantNode", node.value });
+    m_memo.emplace(node, id);
+
+    ++m_node_count;
+
+    std::vector<std::complex<double>> arguments;
+
+    for (Id const &child : node.children) {
+        EClass const &child_class = m_classes[Find(child)];
+
+        if (!child_class.constant) {
+            return id;
+        }
+
+        arguments.push_back(child_class.value);
+    }
+
+    std::complex<double> value;
+
+    if (!m_classes[id].constant && Fold(node, arguments, value)) {
+        Union(id, Add(ENode{ "ConstantNode", { }, 0, value }));
+    }
+
+    return Find(id);
+}
+
+bool EGraph::Union(Id lhs, Id rhs)
+{
+    lhs = Find(lhs);
+    rhs = Find(rhs);
+
+    if (lhs == rhs) {
+        return false;
+    }
+
+    if (m_classes[lhs].nodes.size() < m_classes[rhs].nodes.size()) {
+        std::swap(lhs, rhs);
+    }
+
+    EClass &root = m_classes[lhs];
+    EClass &merged = m_classes[rhs];
+
+    m_union_find[rhs] = lhs;
+
+    root.nodes.insert(std::end(root.nodes), std::cbegin(merged.nodes), std::cend(merged.nodes));
+    merged.nodes.clear();
+
+    if (!root.constant && merged.constant) {
+        root.constant = true;
+        root.value = merged.value;
+    }
+
+    return true;
+}
+
+void EGraph::Rebuild()
+{
+    // Merging two classes can make their parents congruent, so the hashcons is rebuilt until no further merges happen
+    for (bool merged = true; merged;) {
+        merged = false;
+
+        std::vector<std::pair<Id, Id>> unions;
+        std::vector<std::pair<Id, std::complex<double>>> folds;
+
+        m_memo.clear();
+
+        for (Id id = 0; id < m_classes.size(); ++id) {
+            if (Find(id) != id) {
+                continue;
+            }
+
+            for (ENode &node : m_classes[id].nodes) {
+                node = Canonicalize(node);
+
+                auto const [memo_it, inserted] = m_memo.emplace(node, id);
+
+                if (!inserted && Find(memo_it->second) != id) {
+                    unions.emplace_back(memo_it->second, id);
+                }
+
+                std::vector<std::complex<double>> arguments;
+                std::complex<double> value;
+
+                for (Id const &child : node.children) {
+                    if (m_classes[Find(child)].constant) {
+                        arguments.push_back(m_classes[Find(child)].value);
+                    }
+                }
+
+                if (!m_classes[id].constant && arguments.size() == node.children.size() && Fold(node, arguments, value)) {
+                    folds.emplace_back(id, value);
+                }
+            }
+        }
+
+        for (auto const &[lhs, rhs] : unions) {
+            merged |= Union(lhs, rhs);
+        }
+
+        for (auto const &[id, value] : folds) {
+            merged |= Union(id, Add(ENode{ "ConstantNode", { }, 0, value }));
+        }
+    }
+
+    m_node_count = 0;
+
+    for (Id id = 0; id < m_classes.size(); ++id) {
+        if (Find(id) != id) {
+            continue;
+        }
+
+        std::vector<ENode> &nodes = m_classes[id].nodes;
+        std::vector<ENode> unique;
+
+        for (ENode &node : nodes) {
+            if (std::find(std::cbegin(unique), std::cend(unique), node) == std::cend(unique)) {
+                unique.push_back(std::move(node));
+            }
+        }
+
+        nodes = std::move(unique);
+        m_node_count += nodes.size();
+    }
+}
+
+EGraph::ENode EGraph::Canonicalize(ENode node) const
+{
+    for (Id &child : node.children) {
+        child = Find(child);
+    }
+
+    return node;
+}
+
+bool EGraph::Fold(ENode const &node, std::vector<std::complex<double>> const &arguments, std::complex<double> &value)
+{
+    if (node.type == "ConstantNode" || node.children.empty()) {
+        return false;
+    }
+    else if (node.type == "AdditionNode") {
+        value = arguments[0] + arguments[1];
+    }
+    else if (node.type == "SubtractionNode") {
+        value = arguments[0] - arguments[1];
+    }
+    else if (node.type == "MultiplicationNode") {
+        value = arguments[0] * arguments[1];
+    }
+    else if (node.type == "DivisionNode") {
+        if (Approximately(arguments[1], 0.0)) {
+            return false;
+        }
+
+        value = arguments[0] / arguments[1];
+    }
+    else if (node.type == "ExponentiationNode") {
+        value = std::pow(arguments[0], arguments[1]);
+    }
+    else if (node.type == "CosNode") {
+        value = std::cos(arguments[0]);
+    }
+    else if (node.type == "SinNode") {
+        value = std::sin(arguments[0]);
+    }
+    else if (node.type == "TanNode") {
+        value = std::tan(arguments[0]);
+    }
+    else if (node.type == "AcosNode") {
+        value = std::acos(arguments[0]);
+    }
+    else if (node.type == "AsinNode") {
+        value = std::asin(arguments[0]);
+    }
+    else if (node.type == "AtanNode") {
+        value = std::atan(arguments[0]);
+    }
+    else if (node.type == "SqrtNode") {
+        value = std::sqrt(arguments[0]);
+    }
+    else if (node.type == "AbsNode") {
+        value = std::abs(arguments[0]);
+    }
+    else if (node.type == "ExpNode") {
+        value = std::exp(arguments[0]);
+    }
+    else if (node.type == "LnNode") {
+        value = std::log(arguments[0]);
+    }
+    else {
+        return false;
+    }
+
+    return std::isfinite(value.real()) && std::isfinite(value.imag());
+}
+
+Scalar EGraph::Construct(std::string const &type, std::vector<Scalar> const &arguments)
+{
+    if (type == "AdditionNode") {
+        return Scalar(new AdditionNode({ arguments[0], arguments[1] }));
+    }
+    else if (type == "SubtractionNode") {
+        return Scalar(new SubtractionNode({ arguments[0], arguments[1] }));
+    }
+    else if (type == "MultiplicationNode") {
+        return Scalar(new MultiplicationNode({ arguments[0], arguments[1] }));
+    }
+    else if (type == "DivisionNode") {
+        return Scalar(new DivisionNode({ arguments[0], arguments[1] }));
+    }
+    else if (type == "ExponentiationNode") {
+        return Scalar(new ExponentiationNode({ arguments[0], arguments[1] }));
+    }
+    else if (type == "CosNode") {
+        return Scalar(new CosNode({ arguments[0] }));
+    }
+    else if (type == "SinNode") {
+        return Scalar(new SinNode({ arguments[0] }));
+    }
+    else if (type == "TanNode") {
+        return Scalar(new TanNode({ arguments[0] }));
+    }
+    else if (type == "AcosNode") {
+        return Scalar(new AcosNode({ arguments[0] }));
+    }
+    else if (type == "AsinNode") {
+        return Scalar(new AsinNode({ arguments[0] }));
+    }
+    else if (type == "AtanNode") {
+        return Scalar(new AtanNode({ arguments[0] }));
+    }
+    else if (type == "SqrtNode") {
+        return Scalar(new SqrtNode({ arguments[0] }));
+    }
+    else if (type == "AbsNode") {
+        return Scalar(new AbsNode({ arguments[0] }));
+    }
+    else if (type == "ExpNode") {
+        return Scalar(new ExpNode({ arguments[0] }));
+    }
+    else if (type == "LnNode") {
+        return Scalar(new LnNode({ arguments[0] }));
+    }
+
+    throw std::invalid_argument("EGraph: Unrecognized node type");
+}
+
+void EGraph::Match(Pattern const &pattern, Id const &id, Substitution const &substitution, std::vector<Substitution> &substitutions) const
+{
+    EClass const &eclass = m_classes[Find(id)];
+
+    if (pattern.kind == Pattern::Kind::Variable) {
+        auto bound_it = substitution.find(pattern.name);
+
+        if (bound_it == std::cend(substitution)) {
+            Substitution extended = substitution;
+
+            extended.emplace(pattern.name, Find(id));
+            substitutions.push_back(extended);
+        }
+        else if (Find(bound_it->second) == Find(id)) {
+            substitutions.push_back(substitution);
+        }
+    }
+    else if (pattern.kind == Pattern::Kind::Constant) {
+        if (eclass.constant && Approximately(eclass.value, pattern.value)) {
+            substitutions.push_back(substitution);
+        }
+    }
+    else {
+        for (ENode const &node : eclass.nodes) {
+            if (node.type == pattern.name && node.children.size() == pattern.arguments.size()) {
+                Match(pattern.arguments, node.children, 0, substitution, substitutions);
+            }
+        }
+    }
+}
+
+void EGraph::Match(std::vector<Pattern> const &patterns, std::vector<Id> const &ids, size_t const &index, Substitution const &substitution, std::vector<Substitution> &substitutions) const
+{
+    if (index == patterns.size()) {
+        substitutions.push_back(substitution);
+
+        return;
+    }
+
+    std::vector<Substitution> partial;
+
+    Match(patterns[index], ids[index], substitution, partial);
+
+    for (Substitution const &extended : partial) {
+        Match(patterns, ids, index + 1, extended, substitutions);
+    }
+}
+
+EGraph::Id EGraph::Instantiate(Pattern const &pattern, Substitution const &substitution)
+{
+    if (pattern.kind == Pattern::Kind::Variable) {
+        return Find(substitution.at(pattern.name));
+    }
+    else if (pattern.kind == Pattern::Kind::Constant) {
+        return Add(ENode{ "ConstantNode", { }, 0, pattern.value });
+    }
+
+    ENode node{ pattern.name, { }, 0, 0.0 };
+
+    for (Pattern const &argument : pattern.arguments) {
+        node.children.push_back(Instantiate(argument, substitution));
+    }
+
+    return Add(node);
+}
+
+std::vector<EGraph::Rule> const &EGraph::Rules()
+{
+    static std::vector<Rule> const rules = []() -> std::vector<Rule> {
+        std::vector<std::tuple<std::string, std::string, std::string>> const definitions = {
+            // Identities
+            { "pow-zero", "(^ ?a 0)", "1" },
+            { "pow-one", "(^ ?a 1)", "?a" },
+            { "mul-zero", "(* 0 ?a)", "0" },
+            { "mul-one", "(* 1 ?a)", "?a" },
+            { "div-zero", "(/ 0 ?a)", "0" },
+            { "div-one", "(/ ?a 1)", "?a" },
+            { "div-pow", "(/ ?a (^ ?b ?c))", "(* ?a (^ ?b (* -1 ?c)))" },
+            { "add-zero", "(+ 0 ?a)", "?a" },
+            { "sub-zero", "(- ?a 0)", "?a" },
+            { "sub-neg", "(- ?a ?b)", "(+ ?a (* -1 ?b))" },
+            { "exp-ln", "(exp (ln ?a))", "?a" },
+            { "exp-ln-mul", "(exp (* (ln ?a) ?b))", "(^ ?a ?b)" },
+
+            // Commutativity and associativity
+            { "add-comm", "(+ ?a ?b)", "(+ ?b ?a)" },
+            { "add-assoc", "(+ ?a (+ ?b ?c))", "(+ (+ ?a ?b) ?c)" },
+            { "mul-comm", "(* ?a ?b)", "(* ?b ?a)" },
+            { "mul-assoc", "(* ?a (* ?b ?c))", "(* (* ?a ?b) ?c)" },
+
+            // Combining factors
+            { "mul-square", "(* ?a ?a)", "(^ ?a 2)" },
+            { "mul-pow", "(* ?a (^ ?a ?b))", "(^ ?a (+ ?b 1))" },
+            { "pow-pow", "(* (^ ?a ?b) (^ ?a ?c))", "(^ ?a (+ ?b ?c))" },
+
+            // Combining addends
+            { "add-double", "(+ ?a ?a)", "(* 2 ?a)" },
+            { "add-coefficient", "(+ (* ?b ?a) ?a)", "(* (+ ?b 1) ?a)" },
+
+            // Distributing and factoring
+            { "distribute", "(* ?a (+ ?b ?c))", "(+ (* ?a ?b) (* ?a ?c))" },
+            { "factor", "(+ (* ?a ?b) (* ?a ?c))", "(* ?a (+ ?b ?c))" }
+        };
+
+        std::vector<Rule> rules;
+
+        for (auto const &[name, lhs, rhs] : definitions) {
+            rules.push_back({ name, Parse(lhs), Parse(rhs) });
+        }
+
+        return rules;
+    }();
+
+    return rules;
+}
+
+EGraph::Pattern EGraph::Parse(std::string const &pattern_str)
+{
+    std::vector<std::string> tokens;
+    std::string token;
+
+    for (char const &character : pattern_str) {
+        if (character == '(' || character == ')' || std::isspace(static_cast<unsigned char>(character))) {
+            if (!token.empty()) {
+                tokens.push_back(token);
+                token.clear();
+            }
+
+            if (character == '(' || character == ')') {
+                tokens.push_back(std::string(1, character));
+            }
+        }
+        else {
+            token += character;
+        }
+    }
+
+    if (!token.empty()) {
+        tokens.push_back(token);
+    }
+
+    size_t index = 0;
+
+    Pattern pattern = Parse(tokens, index);
+
+    if (index != tokens.size()) {
+        throw std::invalid_argument("EGraph: Trailing tokens in pattern");
+    }
+
+    return pattern;
+}
+
+EGraph::Pattern EGraph::Parse(std::vector<std::string> const &tokens, size_t &index)
+{
+    static std::map<std::string, std::string> const operations = {
+        { "+", "AdditionNode" },
+        { "-", "SubtractionNode" },
+        { "*", "MultiplicationNode" },
+        { "/", "DivisionNode" },
+        { "^", "ExponentiationNode" },
+        { "cos", "CosNode" },
+        { "sin", "SinNode" },
+        { "tan", "TanNode" },
+        { "acos", "AcosNode" },
+        { "asin", "AsinNode" },
+        { "atan", "AtanNode" },
+        { "sqrt", "SqrtNode" },
+        { "abs", "AbsNode" },
+        { "exp", "ExpNode" },
+        { "ln", "LnNode" }
+    };
+
+    if (index >= tokens.size()) {
+        throw std::invalid_argument("EGraph: Unexpected end of pattern");
+    }
+
+    std::string const token = tokens[index++];
+
+    if (token == "(") {
+        if (index >= tokens.size() || operations.find(tokens[index]) == std::cend(operations)) {
+            throw std::invalid_argument("EGraph: Unrecognized operation in pattern");
+        }
+
+        Pattern pattern{ Pattern::Kind::Operation, operations.at(tokens[index++]), 0.0, { } };
+
+        while (index < tokens.size() && tokens[index] != ")") {
+            pattern.arguments.push_back(Parse(tokens, index));
+        }
+
+        if (index++ >= tokens.size()) {
+            throw std::invalid_argument("EGraph: Unbalanced parentheses in pattern");
+        }
+
+        return pattern;
+    }
+    else if (token == ")") {
+        throw std::invalid_argument("EGraph: Unbalanced parentheses in pattern");
+    }
+    else if (token[0] == '?') {
+        return Pattern{ Pattern::Kind::Variable, token, 0.0, { } };
+    }
+
+    return Pattern{ Pattern::Kind::Constant, token, std::stod(token), { } };
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <complex>
+#include <chrono>
+#include <limits>
+#include <functional>
+#include <tuple>
+#include <stdexcept>
+#include <cmath>
+#include <cctype>
+
+#include "node.hpp"
+#include "operations.hpp"
+#include "functions.hpp"
+#include "utils.hpp"
+
+class EGraph
+{
+public:
+    using Id = size_t;
+
+    static constexpr std::chrono::milliseconds default_time_budget = std::chrono::milliseconds(50);
+    static constexpr size_t default_node_budget = 20000;
+    static constexpr size_t default_iteration_budget = 32;
+
+private:
+    struct ENode
+    {
+        std::string type;
+        std::vector<Id> children;
+
+        // Variables are identified by their index into the leaves, constants by their value
+        size_t leaf;
+        std::complex<double> value;
+
+        bool operator==(ENode const &other) const;
+    };
+
+    struct ENodeHash
+    {
+        size_t operator()(ENode const &node) const;
+    };
+
+    struct EClass
+    {
+        std::vector<ENode> nodes;
+
+        bool constant;
+        std::complex<double> value;
+    };
+
+    struct Pattern
+    {
+        enum class Kind
+        {
+            Variable,
+            Constant,
+            Operation
+        };
+
+        Kind kind;
+        std::string name;
+        std::complex<double> value;
+        std::vector<Pattern> arguments;
+    };
+
+    struct Rule
+    {
+        std::string name;
+        Pattern lhs;
+        Pattern rhs;
+    };
+
+    using Substitution = std::map<std::string, Id>;
+
+    std::vector<Id> m_union_find;
+    std::vector<EClass> m_classes;
+    std::unordered_map<ENode, Id, ENodeHash> m_memo;
+
+    // Variables compare by identity, so each distinct variable node is kept as a leaf
+    std::vector<Scalar> m_leaves;
+
+    size_t m_node_count;
+
+public:
+    EGraph();
+
+    Id Add(Scalar const &scalar);
+    Id Find(Id id) const;
+
+    bool Saturate(std::chrono::milliseconds const &time_budget = default_time_budget, size_t const &node_budget = default_node_budget, size_t const &iteration_budget = default_iteration_budget);
+    Scalar Extract(Id const &id) const;
+
+    size_t Classes() const;
+    size_t Nodes() const;
+
+private:
+    Id Add(Scalar const &scalar, std::unordered_map<Node const *, Id> &added);
+    Id Add(ENode node);
+    bool Union(Id lhs, Id rhs);
+    void Rebuild();
+
+    ENode Canonicalize(ENode node) const;
+    static bool Fold(ENode const &node, std::vector<std::complex<double>> const &arguments, std::complex<double> &value);
+    static Scalar Construct(std::string const &type, std::vector<Scalar> const &arguments);
+
+    void Match(Pattern const &pattern, Id const &id, Substitution const &substitution, std::vector<Substitution> &substitutions) const;
+    void Match(std::vector<Pattern> const &patterns, std::vector<Id> const &ids, size_t const &index, Substitution const &substitution, std::vector<Substitution> &substitutions) const;
+    Id Instantiate(Pattern const &pattern, Substitution const &substitution);
+
+    static std::vector<Rule> const &Rules();
+    static Pattern Parse(std::string const &pattern_str);
+    static Pattern Parse(std::vector<std::string> const &tokens, size_t &index);
+};
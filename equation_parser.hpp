@@ -36,7 +36,7 @@ class EquationParser
 
             for (size_t i = 0; i < lhs.Rows(); ++i) {
                 for (size_t j = 0; j < lhs.Cols(); ++j) {
-                    if (!Approximately(lhs(i, j)->Value(), rhs(i, j)->Value())) {
+                    if (!Approximately(lhs.Value(i, j), rhs.Value(i, j))) {
                         return false;
                     }
                 }
@@ -25,7 +25,7 @@ void ExpressionComposer::Compose(std::ostream &ostream) const
 void ExpressionComposer::Compose(std::ostream &ostream, std::variant<Scalar, Matrix> const &node_variant, uint32_t const &precedence) const
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
+        Matrix const &matrix = std::get<Matrix>(node_variant);
 
         ostream << "\\begin{bmatrix}";
 
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "expression_eliminator.hpp"
+
+std::variant<std::complex<double>, NumericMatrix> ExpressionEliminator::Let::Evaluate() const
+{
+    for (Binding const &binding : bindings) {
+        *binding.temporary = binding.definition->Value();
+    }
+
+    return Value();
+}
+
+std::variant<std::complex<double>, NumericMatrix> ExpressionEliminator::Let::Evaluate(std::vector<Scalar> const &changed) const
+{
+    std::unordered_set<Node const *> dirty;
+
+    for (Scalar const &variable : changed) {
+        dirty.insert(variable.get());
+    }
+
+    // A definition only reads temporaries bound before it, whose state is already settled, so a remembered answer never goes stale
+    std::unordered_map<Node const *, bool> stale;
+
+    std::function<bool(Scalar const &)> depends = [&dirty, &stale, &depends](Scalar const &scalar) -> bool {
+        if (dirty.count(scalar.get()) > 0) {
+            return true;
+        }
+
+        auto stale_it = stale.find(scalar.get());
+
+        if (stale_it != std::end(stale)) {
+            return stale_it->second;
+        }
+
+        bool const result = std::any_of(std::cbegin(scalar->Arguments()), std::cend(scalar->Arguments()), depends);
+
+        stale.emplace(scalar.get(), result);
+
+        return result;
+    };
+
+    // A reassigned temporary in turn dirties the bindings that read it
+    for (Binding const &binding : bindings) {
+        if (depends(binding.definition)) {
+            *binding.temporary = binding.definition->Value();
+
+            dirty.insert(binding.temporary.get());
+        }
+    }
+
+    return Value();
+}
+
+std::variant<std::complex<double>, NumericMatrix> ExpressionEliminator::Let::Value() const
+{
+    if (std::holds_alternative<Matrix>(result)) {
+        return std::get<Matrix>(result).Evaluate();
+    }
+    else if (std::holds_alternative<Scalar>(result)) {
+        return std::get<Scalar>(result)->Value();
+    }
+
+    throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
+}
+
+ExpressionEliminator::ExpressionEliminator(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map) : m_node_variant(node_variant), m_node_map(node_map)
+{
+}
+
+std::variant<Scalar, Matrix> ExpressionEliminator::Eliminate()
+{
+    if (std::holds_alternative<Matrix>(m_node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(m_node_variant);
+
+        std::vector<Scalar> elements;
+
+        // Elements share one table, so a subtree repeated across elements is merged as well
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                elements.push_back(Eliminate(matrix(i, j)));
+            }
+        }
+
+        return Matrix(matrix.Rows(), matrix.Cols(), elements);
+    }
+    else if (std::holds_alternative<Scalar>(m_node_variant)) {
+        return Eliminate(std::get<Scalar>(m_node_variant));
+    }
+
+    throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
+}
+
+ExpressionEliminator::Let ExpressionEliminator::Bind()
+{
+    std::variant<Scalar, Matrix> const node_variant = Eliminate();
+
+    std::vector<Scalar> roots;
+
+    if (std::holds_alternative<Matrix>(node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(node_variant);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                roots.push_back(matrix(i, j));
+            }
+        }
+    }
+    else {
+        roots.push_back(std::get<Scalar>(node_variant));
+    }
+
+    std::unordered_map<Scalar, size_t> uses;
+
+    for (Scalar const &root : roots) {
+        if (++uses[root] == 1) {
+            Count(root, uses);
+        }
+    }
+
+    Let let;
+
+    std::unordered_map<Scalar, Scalar> bound;
+
+    std::transform(std::cbegin(roots), std::cend(roots), std::begin(roots), [this, &uses, &bound, &let](Scalar const &root) -> Scalar {
+        return Bind(root, uses, bound, let.bindings);
+    });
+
+    if (std::holds_alternative<Matrix>(node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(node_variant);
+
+        let.result = Matrix(matrix.Rows(), matrix.Cols(), roots);
+    }
+    else {
+        let.result = roots.front();
+    }
+
+    return let;
+}
+
+std::string ExpressionEliminator::Compose()
+{
+    std::ostringstream ostringstream;
+
+    Compose(ostringstream);
+
+    return ostringstream.str();
+}
+
+void ExpressionEliminator::Compose(std::ostream &ostream)
+{
+    Let const let = Bind();
+
+    std::map<std::string, std::variant<Scalar, Matrix>> node_map = m_node_map;
+
+    for (Binding const &binding : let.bindings) {
+        node_map.emplace(binding.name, binding.temporary);
+    }
+
+    // t_{0}=...\\t_{1}=...\\result
+    for (Binding const &binding : let.bindings) {
+        ostream << binding.name << "=" << ExpressionComposer(binding.definition, node_map) << "\\\\";
+    }
+
+    ostream << ExpressionComposer(let.result, node_map);
+}
+
+Scalar ExpressionEliminator::Eliminate(Scalar const &scalar)
+{
+    auto merged_it = m_merged.find(scalar);
+
+    if (merged_it != std::end(m_merged)) {
+        return merged_it->second;
+    }
+
+    std::vector<Scalar> arguments;
+
+    std::transform(std::cbegin(scalar->Arguments()), std::cend(scalar->Arguments()), std::back_inserter(arguments), [this](Scalar const &argument) -> Scalar {
+        return Eliminate(argument);
+    });
+
+    std::ostringstream key;
+
+    key << scalar->Type();
+
+    if (scalar->Type() == "ConstantNode") {
+        key << std::setprecision(17) << ':' << scalar->Value().real() << ':' << scalar->Value().imag();
+    }
+    else if (arguments.empty()) {
+        // Variables are distinguished by identity
+        key << ':' << scalar.get();
+    }
+    else {
+        // Arguments are already merged, so their addresses identify them structurally
+        std::vector<Node const *> argument_keys;
+
+        std::transform(std::cbegin(arguments), std::cend(arguments), std::back_inserter(argument_keys), [](Scalar const &argument) -> Node const * { return argument.get(); });
+
+        // Only addition and multiplication ignore the order of their arguments
+        if (scalar->Type() == "AdditionNode" || scalar->Type() == "MultiplicationNode") {
+            std::sort(std::begin(argument_keys), std::end(argument_keys));
+        }
+
+        for (Node const *argument_key : argument_keys) {
+            key << ':' << argument_key;
+        }
+    }
+
+    Scalar const merged = m_nodes.emplace(key.str(), Node::Rebuild(scalar, arguments)).first->second;
+
+    m_merged.emplace(scalar, merged);
+
+    return merged;
+}
+
+Scalar ExpressionEliminator::Bind(Scalar const &scalar, std::unordered_map<Scalar, size_t> const &uses, std::unordered_map<Scalar, Scalar> &bound, std::vector<Binding> &bindings) const
+{
+    auto bound_it = bound.find(scalar);
+
+    if (bound_it != std::end(bound)) {
+        return bound_it->second;
+    }
+
+    std::vector<Scalar> arguments;
+
+    std::transform(std::cbegin(scalar->Arguments()), std::cend(scalar->Arguments()), std::back_inserter(arguments), [this, &uses, &bound, &bindings](Scalar const &argument) -> Scalar {
+        return Bind(argument, uses, bound, bindings);
+    });
+
+    Scalar definition = Node::Rebuild(scalar, arguments);
+
+    // Leaves are cheaper to repeat than to bind, only operations used more than once get a temporary
+    if (!arguments.empty() && uses.at(scalar) > 1) {
+        std::shared_ptr<VariableNode> temporary(new VariableNode());
+
+        bindings.push_back({ "t_{" + std::to_string(bindings.size()) + "}", temporary, definition });
+
+        definition = temporary;
+    }
+
+    bound.emplace(scalar, definition);
+
+    return definition;
+}
+
+void ExpressionEliminator::Count(Scalar const &scalar, std::unordered_map<Scalar, size_t> &uses)
+{
+    for (Scalar const &argument : scalar->Arguments()) {
+        // Each node is descended into once, later parents only add to its count
+        if (++uses[argument] == 1) {
+            Count(argument, uses);
+        }
+    }
+}
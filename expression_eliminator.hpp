@@ -0,0 +1,72 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+
+#include "node.hpp"
+#include "matrix.hpp"
+#include "numeric_matrix.hpp"
+#include "operations.hpp"
+#include "functions.hpp"
+#include "utils.hpp"
+#include "expression_composer.hpp"
+
+class ExpressionEliminator
+{
+public:
+    // A temporary holds the value of its definition once the bindings before it have been evaluated
+    struct Binding
+    {
+        std::string name;
+        std::shared_ptr<VariableNode> temporary;
+        Scalar definition;
+    };
+
+    struct Let
+    {
+        std::vector<Binding> bindings;
+        std::variant<Scalar, Matrix> result;
+
+        // Each shared computation is evaluated once, in binding order, before the result
+        std::variant<std::complex<double>, NumericMatrix> Evaluate() const;
+
+        // Temporaries that depend on none of the changed variables keep their value from the previous evaluation
+        std::variant<std::complex<double>, NumericMatrix> Evaluate(std::vector<Scalar> const &changed) const;
+
+        std::variant<std::complex<double>, NumericMatrix> Value() const;
+    };
+
+private:
+    std::variant<Scalar, Matrix> m_node_variant;
+    std::map<std::string, std::variant<Scalar, Matrix>> m_node_map;
+
+    // Structurally identical subtrees are merged into the first node seen with their key
+    std::unordered_map<std::string, Scalar> m_nodes;
+    std::unordered_map<Scalar, Scalar> m_merged;
+
+public:
+    ExpressionEliminator(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map = { });
+
+    std::variant<Scalar, Matrix> Eliminate();
+    Let Bind();
+
+    std::string Compose();
+    void Compose(std::ostream &ostream);
+
+private:
+    Scalar Eliminate(Scalar const &scalar);
+    Scalar Bind(Scalar const &scalar, std::unordered_map<Scalar, size_t> const &uses, std::unordered_map<Scalar, Scalar> &bound, std::vector<Binding> &bindings) const;
+
+    static void Count(Scalar const &scalar, std::unordered_map<Scalar, size_t> &uses);
+};
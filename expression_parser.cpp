@@ -103,7 +103,7 @@ std::string ExpressionParser::Matrices(std::string const &expression_str)
         std::string matrix_name = m_parser_context->NextMatrixName();
 
 
-        Matrix matrix(rows, cols, flattened);
+        Matrix matrix = SparseMatrix::Worthwhile(rows, cols, flattened) ? Matrix(SparseMatrix(rows, cols, flattened)) : Matrix(rows, cols, flattened);
         
         m_node_map.emplace(matrix_name, matrix);
 
@@ -185,7 +185,7 @@ std::variant<Scalar, Matrix> ExpressionParser::Brackets(std::string const &expre
 
 std::variant<Scalar, Matrix> ExpressionParser::Functions(std::string const &expression_str)
 {
-    std::regex function_regex("^(.*)(cos|sin|tan|acos|asin|atan|sqrt|abs|exp|ln|det|inv)(E_\\d+)(.*?)$|^(.*)(\\\\frac)(E_\\d+)(E_\\d+)(.*?)$");
+    std::regex function_regex("^(.*)(cos|sin|tan|acos|asin|atan|sqrt|abs|exp|ln|det|inv)(E_\\d+)(.*?)$|^(.*)(\\\\frac|solve)(E_\\d+)(E_\\d+)(.*?)$");
 
     std::smatch function_match;
 
@@ -250,6 +250,9 @@ std::variant<Scalar, Matrix> ExpressionParser::Functions(std::string const &expr
             if (function_match[6].str() == "\\frac") {
                 function_variant = std::visit(DivisionVisitor{ }, lhs_arg_variant, rhs_arg_variant);
             }
+            else if (function_match[6].str() == "solve") {
+                function_variant = std::visit(SolveVisitor{ }, lhs_arg_variant, rhs_arg_variant);
+            }
             else {
                 throw std::invalid_argument("Unrecognized function: " + function_match[6].str());
             }
@@ -285,10 +288,11 @@ std::variant<Scalar, Matrix> ExpressionParser::Operators(std::string const &expr
             return std::visit(SubtractionVisitor{ }, lhs_arg_variant, rhs_arg_variant);
         }
         else if (operator_match[5].str() == "*") {
-            std::variant<Scalar, Matrix> lhs_arg_variant = Operators(operator_match[4].str());
-            std::variant<Scalar, Matrix> rhs_arg_variant = Operators(operator_match[6].str());
+            std::vector<std::variant<Scalar, Matrix>> factors;
 
-            return std::visit(MultiplicationVisitor{ }, lhs_arg_variant, rhs_arg_variant);
+            Products(expression_str, factors);
+
+            return Product(factors);
         }
         else if (operator_match[5].str() == "/") {
             std::variant<Scalar, Matrix> lhs_arg_variant = Operators(operator_match[4].str());
@@ -317,6 +321,23 @@ std::variant<Scalar, Matrix> ExpressionParser::Operators(std::string const &expr
     return Nodes(expression_str);
 }
 
+void ExpressionParser::Products(std::string const &expression_str, std::vector<std::variant<Scalar, Matrix>> &factors)
+{
+    std::regex product_regex("^(.*[^\\+\\-\\*\\/\\^])([\\*\\/])(.*)$");
+
+    std::smatch product_match;
+
+    // Collect the factors of a left-associative product chain, a division ends the chain and is parsed as a single factor
+    if (std::regex_search(std::cbegin(expression_str), std::cend(expression_str), product_match, product_regex) && product_match[2].str() == "*") {
+        Products(product_match[1].str(), factors);
+
+        factors.push_back(Operators(product_match[3].str()));
+    }
+    else {
+        factors.push_back(Operators(expression_str));
+    }
+}
+
 std::variant<Scalar, Matrix> ExpressionParser::Nodes(std::string const &expression_str)
 {
     try {
@@ -342,35 +363,115 @@ std::variant<Scalar, Matrix> ExpressionParser::Nodes(std::string const &expressi
     }
 }
 
-std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
+std::variant<Scalar, Matrix> ExpressionParser::Product(std::vector<std::variant<Scalar, Matrix>> const &factors)
 {
-    return Scalar(new AdditionNode({ lhs, rhs }));
-}
+    std::variant<Scalar, Matrix> product;
+    std::vector<Matrix> matrices;
 
-std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Scalar const &lhs, Matrix const &rhs)
-{
-    Matrix matrix(rhs.Rows(), rhs.Cols());
+    bool empty = true;
 
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AdditionNode({ lhs, rhs(i, j) }));
+    // Scalars are folded in order, runs of consecutive matrices are reassociated as a chain first
+    for (size_t i = 0; i <= factors.size(); ++i) {
+        if (i < factors.size() && std::holds_alternative<Matrix>(factors[i])) {
+            matrices.push_back(std::get<Matrix>(factors[i]));
+
+            continue;
+        }
+
+        if (!matrices.empty()) {
+            std::variant<Scalar, Matrix> chain = Chain(matrices);
+
+            product = empty ? chain : std::visit(MultiplicationVisitor{ }, product, chain);
+            empty = false;
+
+            matrices.clear();
+        }
+
+        if (i < factors.size()) {
+            product = empty ? factors[i] : std::visit(MultiplicationVisitor{ }, product, factors[i]);
+            empty = false;
         }
     }
-    
-    return matrix;
+
+    return product;
 }
 
-std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
+// Classic O(n^3) matrix chain ordering, minimizing the scalar multiplications of the whole product
+Matrix ExpressionParser::Chain(std::vector<Matrix> const &matrices)
 {
-    Matrix matrix(lhs.Rows(), lhs.Cols());
+    size_t const count = matrices.size();
 
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AdditionNode({ lhs(i, j), rhs }));
+    bool conformable = true;
+
+    for (size_t i = 0; i + 1 < count; ++i) {
+        conformable = conformable && matrices[i].Cols() == matrices[i + 1].Rows();
+    }
+
+    if (count < 3 || !conformable) {
+        Matrix product = matrices.front();
+
+        for (size_t i = 1; i < count; ++i) {
+            product = std::get<Matrix>(MultiplicationVisitor{ }(product, matrices[i]));
         }
+
+        return product;
     }
-    
-    return matrix;
+
+    std::vector<size_t> dims(count + 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        dims[i] = matrices[i].Rows();
+    }
+
+    dims[count] = matrices.back().Cols();
+
+    std::vector<double> costs(count * count, 0.0);
+    std::vector<size_t> splits(count * count, 0);
+
+    for (size_t length = 2; length <= count; ++length) {
+        for (size_t first = 0; first + length <= count; ++first) {
+            size_t const last = first + length - 1;
+
+            costs[first * count + last] = std::numeric_limits<double>::infinity();
+
+            for (size_t split = first; split < last; ++split) {
+                double const cost = costs[first * count + split] + costs[(split + 1) * count + last] + static_cast<double>(dims[first]) * dims[split + 1] * dims[last + 1];
+
+                if (cost < costs[first * count + last]) {
+                    costs[first * count + last] = cost;
+                    splits[first * count + last] = split;
+                }
+            }
+        }
+    }
+
+    return Chain(matrices, splits, 0, count - 1);
+}
+
+Matrix ExpressionParser::Chain(std::vector<Matrix> const &matrices, std::vector<size_t> const &splits, size_t const &first, size_t const &last)
+{
+    if (first == last) {
+        return matrices[first];
+    }
+
+    size_t const split = splits[first * matrices.size() + last];
+
+    return std::get<Matrix>(MultiplicationVisitor{ }(Chain(matrices, splits, first, split), Chain(matrices, splits, split + 1, last)));
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
+{
+    return Scalar(new AdditionNode({ lhs, rhs }));
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Scalar const &lhs, Matrix const &rhs)
+{
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Addition, lhs, rhs));
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
+{
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Addition, lhs, rhs));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Matrix const &lhs, Matrix const &rhs)
@@ -379,15 +480,7 @@ std::variant<Scalar, Matrix> ExpressionParser::AdditionVisitor::operator()(Matri
         throw std::invalid_argument("AdditionVisitor: Dimensions are not equal");
     }
 
-    Matrix matrix(lhs.Rows(), lhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AdditionNode({ lhs(i, j), rhs(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return lhs.Add(rhs);
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
@@ -397,28 +490,12 @@ std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Sc
 
 std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Scalar const &lhs, Matrix const &rhs)
 {
-    Matrix matrix(rhs.Rows(), rhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new SubtractionNode({ lhs, rhs(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Subtraction, lhs, rhs));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
 {
-    Matrix matrix(lhs.Rows(), lhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new SubtractionNode({ lhs(i, j), rhs }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Subtraction, lhs, rhs));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Matrix const &lhs, Matrix const &rhs)
@@ -427,15 +504,7 @@ std::variant<Scalar, Matrix> ExpressionParser::SubtractionVisitor::operator()(Ma
         throw std::invalid_argument("SubtractionVisitor: Dimensions are not equal");
     }
 
-    Matrix matrix(lhs.Rows(), lhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new SubtractionNode({ lhs(i, j), rhs(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return lhs.Subtract(rhs);
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
@@ -445,28 +514,16 @@ std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()
 
 std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()(Scalar const &lhs, Matrix const &rhs)
 {
-    Matrix matrix(rhs.Rows(), rhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new MultiplicationNode({ lhs, rhs(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return rhs.Scale(lhs);
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
 {
-    Matrix matrix(lhs.Rows(), lhs.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new MultiplicationNode({ lhs(i, j), rhs }));
-        }
+    if (lhs.Sparse()) {
+        return lhs.Scale(rhs);
     }
-    
-    return matrix;
+
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Multiplication, lhs, rhs));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()(Matrix const &lhs, Matrix const &rhs)
@@ -475,23 +532,7 @@ std::variant<Scalar, Matrix> ExpressionParser::MultiplicationVisitor::operator()
         throw std::invalid_argument("MultiplicationVisitor: LHS cols must equal RHS rows");
     }
 
-    Matrix matrix(lhs.Rows(), rhs.Cols());
-
-    for (size_t i = 0; i < lhs.Rows(); ++i) {
-        for (size_t j = 0; j < rhs.Cols(); ++j) {
-            Scalar sum(new ConstantNode(0.0));
-
-            for (size_t k = 0; k < lhs.Cols(); ++k) {
-                Scalar product(new MultiplicationNode({ lhs(i, k), rhs(k, j) }));
-                
-                sum = Scalar(new AdditionNode({ sum, product }));
-            }
-
-            matrix(i, j) = sum;
-        }
-    }
-
-    return matrix;
+    return lhs.Multiply(rhs);
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::DivisionVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
@@ -514,6 +555,30 @@ std::variant<Scalar, Matrix> ExpressionParser::DivisionVisitor::operator()(Matri
     throw std::invalid_argument("DivisionVisitor unrecognized arguments Matrix and Matrix");
 }
 
+std::variant<Scalar, Matrix> ExpressionParser::SolveVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
+{
+    return Scalar(new DivisionNode({ rhs, lhs }));
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::SolveVisitor::operator()(Scalar const &lhs, Matrix const &rhs)
+{
+    throw std::invalid_argument("SolveVisitor unrecognized arguments Scalar and Matrix");
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::SolveVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
+{
+    throw std::invalid_argument("SolveVisitor unrecognized arguments Matrix and Scalar");
+}
+
+std::variant<Scalar, Matrix> ExpressionParser::SolveVisitor::operator()(Matrix const &lhs, Matrix const &rhs)
+{
+    if (lhs.Rows() != rhs.Rows()) {
+        throw std::invalid_argument("SolveVisitor: LHS rows must equal RHS rows");
+    }
+
+    return lhs.Solve(rhs);
+}
+
 std::variant<Scalar, Matrix> ExpressionParser::ExponentiationVisitor::operator()(Scalar const &lhs, Scalar const &rhs)
 {
     return Scalar(new ExponentiationNode({ lhs, rhs }));
@@ -526,7 +591,17 @@ std::variant<Scalar, Matrix> ExpressionParser::ExponentiationVisitor::operator()
 
 std::variant<Scalar, Matrix> ExpressionParser::ExponentiationVisitor::operator()(Matrix const &lhs, Scalar const &rhs)
 {
-    throw std::invalid_argument("ExponentiationVisitor unrecognized arguments Matrix and Scalar");
+    if (!Node::Constant(rhs)) {
+        throw std::invalid_argument("ExponentiationVisitor: Matrix exponent must be constant");
+    }
+
+    std::complex<double> exponent = rhs->Value();
+
+    if (!Approximately(exponent.imag(), 0.0) || !Approximately(exponent.real(), std::round(exponent.real())) || std::fabs(exponent.real()) > std::numeric_limits<int32_t>::max()) {
+        throw std::invalid_argument("ExponentiationVisitor: Matrix exponent must be an integer");
+    }
+
+    return lhs.Pow(static_cast<int32_t>(std::round(exponent.real())));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::ExponentiationVisitor::operator()(Matrix const &lhs, Matrix const &rhs)
@@ -541,15 +616,7 @@ std::variant<Scalar, Matrix> ExpressionParser::CosVisitor::operator()(Scalar con
 
 std::variant<Scalar, Matrix> ExpressionParser::CosVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new CosNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Cos, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::SinVisitor::operator()(Scalar const &arg)
@@ -559,15 +626,7 @@ std::variant<Scalar, Matrix> ExpressionParser::SinVisitor::operator()(Scalar con
 
 std::variant<Scalar, Matrix> ExpressionParser::SinVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new SinNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Sin, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::TanVisitor::operator()(Scalar const &arg)
@@ -577,15 +636,7 @@ std::variant<Scalar, Matrix> ExpressionParser::TanVisitor::operator()(Scalar con
 
 std::variant<Scalar, Matrix> ExpressionParser::TanVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new TanNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Tan, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::AcosVisitor::operator()(Scalar const &arg)
@@ -595,15 +646,7 @@ std::variant<Scalar, Matrix> ExpressionParser::AcosVisitor::operator()(Scalar co
 
 std::variant<Scalar, Matrix> ExpressionParser::AcosVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AcosNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Acos, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::AsinVisitor::operator()(Scalar const &arg)
@@ -613,15 +656,7 @@ std::variant<Scalar, Matrix> ExpressionParser::AsinVisitor::operator()(Scalar co
 
 std::variant<Scalar, Matrix> ExpressionParser::AsinVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AsinNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Asin, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::AtanVisitor::operator()(Scalar const &arg)
@@ -631,15 +666,7 @@ std::variant<Scalar, Matrix> ExpressionParser::AtanVisitor::operator()(Scalar co
 
 std::variant<Scalar, Matrix> ExpressionParser::AtanVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AtanNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Atan, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::SqrtVisitor::operator()(Scalar const &arg)
@@ -649,15 +676,7 @@ std::variant<Scalar, Matrix> ExpressionParser::SqrtVisitor::operator()(Scalar co
 
 std::variant<Scalar, Matrix> ExpressionParser::SqrtVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new SqrtNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Sqrt, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::AbsVisitor::operator()(Scalar const &arg)
@@ -667,15 +686,7 @@ std::variant<Scalar, Matrix> ExpressionParser::AbsVisitor::operator()(Scalar con
 
 std::variant<Scalar, Matrix> ExpressionParser::AbsVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new AbsNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Abs, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::ExpVisitor::operator()(Scalar const &arg)
@@ -685,15 +696,7 @@ std::variant<Scalar, Matrix> ExpressionParser::ExpVisitor::operator()(Scalar con
 
 std::variant<Scalar, Matrix> ExpressionParser::ExpVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new ExpNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Exp, arg));
 }
 
 std::variant<Scalar, Matrix> ExpressionParser::LnVisitor::operator()(Scalar const &arg)
@@ -703,15 +706,7 @@ std::variant<Scalar, Matrix> ExpressionParser::LnVisitor::operator()(Scalar cons
 
 std::variant<Scalar, Matrix> ExpressionParser::LnVisitor::operator()(Matrix const &arg)
 {
-    Matrix matrix(arg.Rows(), arg.Cols());
-
-    for (size_t i = 0; i < matrix.Rows(); ++i) {
-        for (size_t j = 0; j < matrix.Cols(); ++j) {
-            matrix(i, j) = Scalar(new LnNode({ arg(i, j) }));
-        }
-    }
-    
-    return matrix;
+    return Matrix(MatrixExpression::Unary(MatrixExpression::Operation::Ln, arg));
 }
 
 ExpressionParser::SubmatrixVisitor::SubmatrixVisitor(size_t const &row, size_t const &col) : m_row(row), m_col(col)
@@ -12,12 +12,14 @@
 #include <regex>
 #include <variant>
 #include <iostream>
+#include <limits>
 
 #include "node.hpp"
 #include "operations.hpp"
 #include "functions.hpp"
 #include "utils.hpp"
 #include "matrix.hpp"
+#include "matrix_expression.hpp"
 #include "complex_parser.hpp"
 
 class ExpressionParserContext
@@ -67,8 +69,13 @@ private:
     std::variant<Scalar, Matrix> Brackets(std::string const &expression_str);
     std::variant<Scalar, Matrix> Functions(std::string const &expression_str);
     std::variant<Scalar, Matrix> Operators(std::string const &expression_str);
+    void Products(std::string const &expression_str, std::vector<std::variant<Scalar, Matrix>> &factors);
     std::variant<Scalar, Matrix> Nodes(std::string const &expression_str);
 
+    static std::variant<Scalar, Matrix> Product(std::vector<std::variant<Scalar, Matrix>> const &factors);
+    static Matrix Chain(std::vector<Matrix> const &matrices);
+    static Matrix Chain(std::vector<Matrix> const &matrices, std::vector<size_t> const &splits, size_t const &first, size_t const &last);
+
 private:    
     struct AdditionVisitor
     {
@@ -102,6 +109,14 @@ private:
         std::variant<Scalar, Matrix> operator()(Matrix const &lhs, Matrix const &rhs);
     };
 
+    struct SolveVisitor
+    {
+        std::variant<Scalar, Matrix> operator()(Scalar const &lhs, Scalar const &rhs);
+        std::variant<Scalar, Matrix> operator()(Scalar const &lhs, Matrix const &rhs);
+        std::variant<Scalar, Matrix> operator()(Matrix const &lhs, Scalar const &rhs);
+        std::variant<Scalar, Matrix> operator()(Matrix const &lhs, Matrix const &rhs);
+    };
+
     struct ExponentiationVisitor
     {
         std::variant<Scalar, Matrix> operator()(Scalar const &lhs, Scalar const &rhs);
@@ -3,215 +3,254 @@
  */
 
 #include "expression_simplifier.hpp"
+#include "thread_pool.hpp"
 
-ExpressionSimplifier::ExpressionSimplifier(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map) : m_node_variant(node_variant), m_node_map(node_map)
+ExpressionSimplifier::ExpressionSimplifier(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map, std::shared_ptr<SimplificationCache> const &cache) : m_node_variant(node_variant), m_node_map(node_map), m_cache(cache), m_start(std::chrono::steady_clock::now()), m_rewrites(std::make_shared<std::atomic<size_t>>(0)), m_truncated(false), m_depth(0)
 {
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Simplify()
 {
-    std::variant<Scalar, Matrix> distributed_ptr = ExpressionSimplifier(m_node_variant, m_node_map).Distribute();
-    std::variant<Scalar, Matrix> combined_factors_ptr = ExpressionSimplifier(distributed_ptr, m_node_map).CombineFactors();
-    std::variant<Scalar, Matrix> combined_addends_ptr = ExpressionSimplifier(combined_factors_ptr, m_node_map).CombineAddends();
-    std::variant<Scalar, Matrix> factorized_ptr = ExpressionSimplifier(combined_addends_ptr, m_node_map).Factorize();
+    return Simplify(Budget());
+}
+
+std::variant<Scalar, Matrix> ExpressionSimplifier::Simplify(Budget const &budget)
+{
+    m_budget = budget;
+    m_start = std::chrono::steady_clock::now();
+    m_rewrites = std::make_shared<std::atomic<size_t>>(0);
+    m_truncated = false;
+
+    std::variant<Scalar, Matrix> node_variant = m_node_variant;
+    std::variant<Scalar, Matrix> smallest = node_variant;
+
+    size_t smallest_size = Size(smallest);
+
+    std::vector<std::pair<std::string, Pass>> const passes = {
+        { "Distribute", &ExpressionSimplifier::Distribute },
+        { "CombineFactors", &ExpressionSimplifier::CombineFactors },
+        { "CombineAddends", &ExpressionSimplifier::CombineAddends },
+        { "Factorize", &ExpressionSimplifier::Factorize }
+    };
+
+    // Every pass runs on this simplifier, so they share its keys, hashes and budget
+    for (auto const &[name, pass] : passes) {
+        node_variant = Run("Identify", &ExpressionSimplifier::Identify, Run(name, pass, node_variant));
+
+        size_t const size = Size(node_variant);
+
+        if (size > m_budget.nodes) {
+            m_truncated = true;
+        }
+        else if (size < smallest_size) {
+            smallest = node_variant;
+            smallest_size = size;
+        }
+
+        if (m_truncated) {
+            return smallest;
+        }
+    }
 
-    return factorized_ptr;
+    return node_variant;
+}
+
+bool ExpressionSimplifier::Truncated() const
+{
+    return m_truncated;
+}
+
+void ExpressionSimplifier::Instrument(std::shared_ptr<SimplificationStatistics> const &statistics)
+{
+    m_statistics = statistics;
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Identify()
 {
-    return Identify(m_node_variant);
+    return Run("Identify", &ExpressionSimplifier::Identify, m_node_variant);
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Identify(std::variant<Scalar, Matrix> const &node_variant)
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
-
-        for (size_t i = 0; i < matrix.Rows(); ++i) {
-            for (size_t j = 0; j < matrix.Cols(); ++j) {
-                matrix(i, j) = std::get<Scalar>(Identify(matrix(i, j)));
-            }
-        }
-
-        return matrix;
+        return Map(std::get<Matrix>(node_variant), &ExpressionSimplifier::Identify);
     }
     else if (std::holds_alternative<Scalar>(node_variant)) {
-        Scalar scalar = std::get<Scalar>(node_variant);
+        return Memoize(SimplificationCache::Pass::Identify, std::get<Scalar>(node_variant), [this](Scalar scalar) -> Scalar {
+            std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::Identify);
 
-        for (auto &argument : scalar->Arguments()) {
-            argument = std::get<Scalar>(Identify(argument));
-        }
+            scalar = Node::Rebuild(scalar, arguments);
         
-        if (scalar->Type() == "ExponentiationNode") {
-            if (scalar->Argument(1)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
-                    return Scalar(new ConstantNode(1.0));
-                }
-                else if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
-                    return scalar->Argument(0);
-                }
-                else if (scalar->Argument(0)->Type() == "ConstantNode") {
-                    return Scalar(new ConstantNode(std::pow(scalar->Argument(0)->Value(), scalar->Argument(1)->Value())));
+            if (scalar->Type() == "ExponentiationNode") {
+                if (scalar->Argument(1)->Type() == "ConstantNode") {
+                    if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
+                        return Fired("pow-zero", Scalar(new ConstantNode(1.0)));
+                    }
+                    else if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
+                        return Fired("pow-one", scalar->Argument(0));
+                    }
+                    else if (scalar->Argument(0)->Type() == "ConstantNode") {
+                        return Fired("pow-fold", Scalar(new ConstantNode(std::pow(scalar->Argument(0)->Value(), scalar->Argument(1)->Value()))));
+                    }
                 }
             }
-        }
-        else if (scalar->Type() == "MultiplicationNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
-                    return Scalar(new ConstantNode(0.0));
-                }
-                else if (Approximately(scalar->Argument(0)->Value(), 1.0)) {
-                    return scalar->Argument(1);
+            else if (scalar->Type() == "MultiplicationNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
+                        return Fired("mul-zero", Scalar(new ConstantNode(0.0)));
+                    }
+                    else if (Approximately(scalar->Argument(0)->Value(), 1.0)) {
+                        return Fired("mul-one", scalar->Argument(1));
+                    }
+                    else if (scalar->Argument(1)->Type() == "ConstantNode") {
+                        return Fired("mul-fold", Scalar(new ConstantNode(scalar->Argument(0)->Value() * scalar->Argument(1)->Value())));
+                    }
                 }
                 else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                    return Scalar(new ConstantNode(scalar->Argument(0)->Value() * scalar->Argument(1)->Value()));
-                }
-            }
-            else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
-                    return Scalar(new ConstantNode(0.0));
-                }
-                else if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
-                    return scalar->Argument(0);
+                    if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
+                        return Fired("mul-zero", Scalar(new ConstantNode(0.0)));
+                    }
+                    else if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
+                        return Fired("mul-one", scalar->Argument(0));
+                    }
                 }
             }
-        }
-        else if (scalar->Type() == "DivisionNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
-                    return Scalar(new ConstantNode(0.0));
+            else if (scalar->Type() == "DivisionNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
+                        return Fired("div-zero", Scalar(new ConstantNode(0.0)));
+                    }
+                    else if (scalar->Argument(1)->Type() == "ConstantNode") {
+                        return Fired("div-fold", Scalar(new ConstantNode(scalar->Argument(0)->Value() / scalar->Argument(1)->Value())));
+                    }
                 }
                 else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                    return Scalar(new ConstantNode(scalar->Argument(0)->Value() / scalar->Argument(1)->Value()));
-                }
-            }
-            else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
-                    return scalar->Argument(0);
+                    if (Approximately(scalar->Argument(1)->Value(), 1.0)) {
+                        return Fired("div-one", scalar->Argument(0));
+                    }
                 }
-            }
 
-            if (scalar->Argument(1)->Type() == "ExponentiationNode") {
-                if (scalar->Argument(1)->Argument(1)->Type() == "ConstantNode") {
-                    return Scalar(new MultiplicationNode({ scalar->Argument(0), Scalar(new ExponentiationNode({ scalar->Argument(1)->Argument(0), Scalar(new ConstantNode(-1.0 * scalar->Argument(1)->Argument(1)->Value())) })) }));
+                if (scalar->Argument(1)->Type() == "ExponentiationNode") {
+                    if (scalar->Argument(1)->Argument(1)->Type() == "ConstantNode") {
+                        return Fired("div-pow", Scalar(new MultiplicationNode({ scalar->Argument(0), Scalar(new ExponentiationNode({ scalar->Argument(1)->Argument(0), Scalar(new ConstantNode(-1.0 * scalar->Argument(1)->Argument(1)->Value())) })) })));
+                    }
                 }
             }
-        }
-        else if (scalar->Type() == "AdditionNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
-                    return scalar->Argument(1);
+            else if (scalar->Type() == "AdditionNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
+                        return Fired("add-zero", scalar->Argument(1));
+                    }
+                    else if (scalar->Argument(1)->Type() == "ConstantNode") {
+                        return Fired("add-fold", Scalar(new ConstantNode(scalar->Argument(0)->Value() + scalar->Argument(1)->Value())));
+                    }
                 }
                 else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                    return Scalar(new ConstantNode(scalar->Argument(0)->Value() + scalar->Argument(1)->Value()));
-                }
-            }
-            else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
-                    return scalar->Argument(0);
+                    if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
+                        return Fired("add-zero", scalar->Argument(0));
+                    }
                 }
             }
-        }
-        else if (scalar->Type() == "SubtractionNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
-                    return Scalar(new MultiplicationNode({ Scalar(new ConstantNode(-1.0)), scalar->Argument(1) }));
+            else if (scalar->Type() == "SubtractionNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    if (Approximately(scalar->Argument(0)->Value(), 0.0)) {
+                        return Fired("sub-negate", Scalar(new MultiplicationNode({ Scalar(new ConstantNode(-1.0)), scalar->Argument(1) })));
+                    }
+                    else if (scalar->Argument(1)->Type() == "ConstantNode") {
+                        return Fired("sub-fold", Scalar(new ConstantNode(scalar->Argument(0)->Value() - scalar->Argument(1)->Value())));
+                    }
                 }
                 else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                    return Scalar(new ConstantNode(scalar->Argument(0)->Value() - scalar->Argument(1)->Value()));
+                    if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
+                        return Fired("sub-zero", scalar->Argument(0));
+                    }
                 }
-            }
-            else if (scalar->Argument(1)->Type() == "ConstantNode") {
-                if (Approximately(scalar->Argument(1)->Value(), 0.0)) {
-                    return scalar->Argument(0);
+                else {
+                    return Fired("sub-add", Scalar(new AdditionNode({ scalar->Argument(0), Scalar(new MultiplicationNode({ Scalar(new ConstantNode(-1.0)), scalar->Argument(1) })) })));
                 }
             }
-            else {
-                return Scalar(new AdditionNode({ scalar->Argument(0), Scalar(new MultiplicationNode({ Scalar(new ConstantNode(-1.0)), scalar->Argument(1) })) }));
-            }
-        }
-        else if (scalar->Type() == "SinNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::sin(scalar->Argument(0)->Value())));
-            }
-        }
-        else if (scalar->Type() == "CosNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::cos(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "SinNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("sin-fold", Scalar(new ConstantNode(std::sin(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "TanNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::tan(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "CosNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("cos-fold", Scalar(new ConstantNode(std::cos(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "AsinNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::asin(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "TanNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("tan-fold", Scalar(new ConstantNode(std::tan(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "AcosNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::acos(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "AsinNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("asin-fold", Scalar(new ConstantNode(std::asin(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "AtanNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::atan(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "AcosNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("acos-fold", Scalar(new ConstantNode(std::acos(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "SqrtNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::sqrt(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "AtanNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("atan-fold", Scalar(new ConstantNode(std::atan(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "AbsNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::abs(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "SqrtNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("sqrt-fold", Scalar(new ConstantNode(std::sqrt(scalar->Argument(0)->Value()))));
+                }
             }
-        }
-        else if (scalar->Type() == "ExpNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::exp(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "AbsNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("abs-fold", Scalar(new ConstantNode(std::abs(scalar->Argument(0)->Value()))));
+                }
             }
-            else {
-                std::vector<Scalar> factors = Factors(scalar->Argument(0));
-
-                std::vector<Scalar> base_factors;
-                std::vector<Scalar> exp_factors;
+            else if (scalar->Type() == "ExpNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("exp-fold", Scalar(new ConstantNode(std::exp(scalar->Argument(0)->Value()))));
+                }
+                else {
+                    std::vector<Scalar> factors = Factors(scalar->Argument(0));
 
-                std::partition_copy(std::cbegin(factors), std::cend(factors), std::back_inserter(base_factors), std::back_inserter(exp_factors), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "LnNode"; });
+                    std::vector<Scalar> base_factors;
+                    std::vector<Scalar> exp_factors;
 
-                if (base_factors.size() > 0) {
-                    Scalar base_ptr = std::reduce(std::next(std::cbegin(base_factors)), std::cend(base_factors), base_factors.front()->Argument(0), 
-                        [](Scalar const &base_ptr, Scalar const &factor_ptr) { 
-                            return Scalar(new AdditionNode({ base_ptr, factor_ptr->Argument(0) })); 
-                        });
+                    std::partition_copy(std::cbegin(factors), std::cend(factors), std::back_inserter(base_factors), std::back_inserter(exp_factors), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "LnNode"; });
 
-                    if (exp_factors.size() > 0) {
-                        Scalar exp_ptr = std::reduce(std::next(std::cbegin(exp_factors)), std::cend(exp_factors), exp_factors.front(), 
-                            [](Scalar const &exp_ptr, Scalar const &factor_ptr) { 
-                                return Scalar(new MultiplicationNode({ exp_ptr, factor_ptr })); 
+                    if (base_factors.size() > 0) {
+                        Scalar base_ptr = std::reduce(std::next(std::cbegin(base_factors)), std::cend(base_factors), base_factors.front()->Argument(0), 
+                            [](Scalar const &base_ptr, Scalar const &factor_ptr) { 
+                                return Scalar(new AdditionNode({ base_ptr, factor_ptr->Argument(0) })); 
                             });
 
-                        return Scalar(new ExponentiationNode({
-                            base_ptr,
-                            exp_ptr
-                        }));
-                    }
+                        if (exp_factors.size() > 0) {
+                            Scalar exp_ptr = std::reduce(std::next(std::cbegin(exp_factors)), std::cend(exp_factors), exp_factors.front(), 
+                                [](Scalar const &exp_ptr, Scalar const &factor_ptr) { 
+                                    return Scalar(new MultiplicationNode({ exp_ptr, factor_ptr })); 
+                                });
+
+                            return Fired("exp-ln-pow", Scalar(new ExponentiationNode({
+                                base_ptr,
+                                exp_ptr
+                            })));
+                        }
 
-                    return base_ptr;
+                        return Fired("exp-ln", base_ptr);
+                    }
                 }
             }
-        }
-        else if (scalar->Type() == "LnNode") {
-            if (scalar->Argument(0)->Type() == "ConstantNode") {
-                return Scalar(new ConstantNode(std::log(scalar->Argument(0)->Value())));
+            else if (scalar->Type() == "LnNode") {
+                if (scalar->Argument(0)->Type() == "ConstantNode") {
+                    return Fired("ln-fold", Scalar(new ConstantNode(std::log(scalar->Argument(0)->Value()))));
+                }
             }
-        }
 
-        return scalar;
+            return scalar;
+        });
     }
 
     throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
@@ -219,59 +258,37 @@ std::variant<Scalar, Matrix> ExpressionSimplifier::Identify(std::variant<Scalar,
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Distribute()
 {
-    return Identify(Distribute(m_node_variant));
+    return Run("Identify", &ExpressionSimplifier::Identify, Run("Distribute", &ExpressionSimplifier::Distribute, m_node_variant));
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Distribute(std::variant<Scalar, Matrix> const &node_variant)
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
-
-        for (size_t i = 0; i < matrix.Rows(); ++i) {
-            for (size_t j = 0; j < matrix.Cols(); ++j) {
-                matrix(i, j) = std::get<Scalar>(Distribute(matrix(i, j)));
-            }
-        }
-
-        return matrix;
+        return Map(std::get<Matrix>(node_variant), &ExpressionSimplifier::Distribute);
     }
     else if (std::holds_alternative<Scalar>(node_variant)) {
-        Scalar scalar = std::get<Scalar>(node_variant);
-
-        for (auto &argument : scalar->Arguments()) {
-            argument = std::get<Scalar>(Distribute(argument));
-        }
-        
-        std::vector<Scalar> factors = Factors(scalar);
+        return Memoize(SimplificationCache::Pass::Distribute, std::get<Scalar>(node_variant), [this](Scalar scalar) -> Scalar {
+            if (Expandable(scalar)) {
+                // Products of sums are expanded and collected in one sparse polynomial instead of nested addition trees
+                std::vector<Scalar> atoms;
+                std::unordered_map<size_t, size_t> indices;
 
-        if (factors.size() > 0) {
-            Scalar distributed_ptr = factors.front();
+                Polynomial const polynomial = Expand(scalar, atoms, indices);
 
-            for (Scalar const &factor : std::vector<Scalar>(std::next(std::cbegin(factors)), std::cend(factors))) {
-                std::vector<Scalar> lhs_addends = Addends(distributed_ptr);
-                std::vector<Scalar> rhs_addends = Addends(factor);       
-
-                for (auto lhs_addend_it = std::cbegin(lhs_addends); lhs_addend_it != std::cend(lhs_addends); ++lhs_addend_it) {
-                    for (auto rhs_addend_it = std::cbegin(rhs_addends); rhs_addend_it != std::cend(rhs_addends); ++rhs_addend_it) {
-                        Scalar multiplication_ptr(new MultiplicationNode({ 
-                            *lhs_addend_it, 
-                            *rhs_addend_it 
-                        }));
-
-                        if (lhs_addend_it == std::cbegin(lhs_addends) && rhs_addend_it == std::cbegin(rhs_addends)) {
-                            distributed_ptr = multiplication_ptr;
-                        }
-                        else {
-                            distributed_ptr = Scalar(new AdditionNode({ distributed_ptr, multiplication_ptr }));
-                        }
-                    }
+                // An expansion cut short by the budget is not collected, the subtree is left as it is
+                if (Exhausted()) {
+                    return scalar;
                 }
+
+                return Collect(polynomial, atoms);
             }
 
-            return distributed_ptr;
-        }
+            std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::Distribute);
 
-        return scalar;
+            scalar = Node::Rebuild(scalar, arguments);
+
+            return scalar;
+        });
     }
 
     throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
@@ -279,119 +296,114 @@ std::variant<Scalar, Matrix> ExpressionSimplifier::Distribute(std::variant<Scala
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::CombineFactors()
 {
-    return Identify(CombineFactors(m_node_variant));
+    return Run("Identify", &ExpressionSimplifier::Identify, Run("CombineFactors", &ExpressionSimplifier::CombineFactors, m_node_variant));
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::CombineFactors(std::variant<Scalar, Matrix> const &node_variant)
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
+        return Map(std::get<Matrix>(node_variant), &ExpressionSimplifier::CombineFactors);
+    }
+    else if (std::holds_alternative<Scalar>(node_variant)) {
+        return Memoize(SimplificationCache::Pass::CombineFactors, std::get<Scalar>(node_variant), [this](Scalar scalar) -> Scalar {
+            if (scalar->Type() != "MultiplicationNode") {
+                std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::CombineFactors);
 
-        for (size_t i = 0; i < matrix.Rows(); ++i) {
-            for (size_t j = 0; j < matrix.Cols(); ++j) {
-                matrix(i, j) = std::get<Scalar>(CombineFactors(matrix(i, j)));
+                return Node::Rebuild(scalar, arguments);
             }
-        }
 
-        return matrix;
-    }
-    else if (std::holds_alternative<Scalar>(node_variant)) {
-        Scalar scalar = std::get<Scalar>(node_variant);
+            // The whole product chain is combined at its top, so the products nested in it are not collected again on the way down
+            std::vector<Scalar> factors = Factors(scalar);
 
-        for (auto &argument : scalar->Arguments()) {
-            argument = std::get<Scalar>(CombineFactors(argument));
-        }
-        
-        std::vector<Scalar> factors = Factors(scalar);
-
-        if (factors.size() > 0) {
-            std::vector<Scalar> constants;
-            std::vector<Scalar> variables;
-
-            // Separate the factors into their constants and their variables
-            std::partition_copy(std::cbegin(factors), std::cend(factors), std::back_inserter(constants), std::back_inserter(variables), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "ConstantNode"; });
-
-            if (!variables.empty()) {
-                // Assess factors with O(n*(n-1)/2) complexity
-                for (auto lhs_variable_it = std::begin(variables); lhs_variable_it != std::end(variables); ++lhs_variable_it) {
-                    for (auto rhs_variable_it = std::next(lhs_variable_it); rhs_variable_it != std::end(variables); ++rhs_variable_it) {
-                        Scalar lhs_variable;
-                        Scalar rhs_variable;
-                        
-                        // Extract the variable of interest; 
-                        // if the node is of type "ExponentiationNode" we want Argument(0) 
-                        if ((*lhs_variable_it)->Type() == "ExponentiationNode") {
-                            lhs_variable = (*lhs_variable_it)->Argument(0);
+            std::transform(std::cbegin(factors), std::cend(factors), std::begin(factors), [this](Scalar const &factor) -> Scalar {
+                return std::get<Scalar>(CombineFactors(factor));
+            });
+
+            if (factors.size() > 0) {
+                std::vector<Scalar> constants;
+                std::vector<Scalar> variables;
+
+                // Separate the factors into their constants and their variables
+                std::partition_copy(std::cbegin(factors), std::cend(factors), std::back_inserter(constants), std::back_inserter(variables), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "ConstantNode"; });
+
+                if (!variables.empty()) {
+                    struct Power
+                    {
+                        Scalar factor;
+                        Scalar base;
+                        std::vector<Scalar> degrees;
+                    };
+
+                    std::vector<Power> powers;
+                    std::unordered_map<size_t, size_t> bases;
+
+                    // Group the factors by the key of their base, so equal bases meet in one pass instead of pairwise
+                    for (Scalar const &variable : variables) {
+                        Scalar base = variable;
+                        Scalar degree;
+
+                        // If the variable is of type "ExponentiationNode" then our base is Argument(0) and our degree is Argument(1)
+                        // otherwise we have an implied degree of 1
+                        if (variable->Type() == "ExponentiationNode") {
+                            base = variable->Argument(0);
+                            degree = variable->Argument(1);
                         }
                         else {
-                            lhs_variable = (*lhs_variable_it);
+                            degree = Scalar(new ConstantNode(1.0));
                         }
-                        
-                        if ((*rhs_variable_it)->Type() == "ExponentiationNode") {
-                            rhs_variable = (*rhs_variable_it)->Argument(0);
+
+                        auto const [base_it, inserted] = bases.emplace(Key(base), powers.size());
+
+                        if (inserted) {
+                            powers.push_back({ variable, base, { degree } });
                         }
                         else {
-                            rhs_variable = (*rhs_variable_it);
+                            powers[base_it->second].degrees.push_back(degree);
+                        }
+                    }
+
+                    variables.clear();
+
+                    // Add the degrees of each base and exponentiate
+                    for (Power const &power : powers) {
+                        if (power.degrees.size() == 1) {
+                            variables.push_back(power.factor);
                         }
+                        else {
+                            Scalar degree = std::reduce(std::next(std::cbegin(power.degrees)), std::cend(power.degrees), power.degrees.front(),
+                                [](Scalar const &combined_degrees, Scalar const &combined_degree) -> Scalar {
+                                    return Scalar(new AdditionNode({ combined_degrees, combined_degree }));
+                                });
 
-                        // If the variables are equivalent sum their degrees
-                        if (Node::Equivalent(lhs_variable, rhs_variable)) {
-                            Scalar lhs_degree;
-                            Scalar rhs_degree;
-                            
-                            // If the variable is of type "ExponentiationNode" then our degree is Argument(1)
-                            // otherwise we have an implied degree of 1
-                            if ((*lhs_variable_it)->Type() == "ExponentiationNode") {
-                                lhs_degree = (*lhs_variable_it)->Argument(1);
-                            }
-                            else {
-                                lhs_degree = Scalar(new ConstantNode(1.0));
-                            }
-                            
-                            if ((*rhs_variable_it)->Type() == "ExponentiationNode") {
-                                rhs_degree = (*rhs_variable_it)->Argument(1);
-                            }
-                            else {
-                                rhs_degree = Scalar(new ConstantNode(1.0));
-                            }
-
-                            // Add their degrees and exponentiate
-                            *lhs_variable_it = Scalar(new ExponentiationNode({ lhs_variable, Scalar(new AdditionNode({ lhs_degree, rhs_degree })) }));
-
-                            // Remove the old variable
-                            rhs_variable_it = variables.erase(rhs_variable_it);
-
-                            if (rhs_variable_it == std::end(variables)) {
-                                break;
-                            }
+                            variables.push_back(Scalar(new ExponentiationNode({ power.base, degree })));
                         }
                     }
-                }
 
-                // Reduce the factors to a single combined node via repeated MultiplicationNode nodes
-                Scalar combined_factors = std::reduce(std::next(std::cbegin(variables)), std::cend(variables), variables.front(), 
-                    [](Scalar const &combined_factors, Scalar const &combined_factor) { 
-                        return Scalar(new MultiplicationNode({ combined_factors, combined_factor })); 
-                    });
-                
-                // Reduce the constants to a single value via repeated multiplication
-                if (!constants.empty()) {
-                    std::complex<double> coefficient = std::transform_reduce(std::cbegin(constants), std::cend(constants), std::complex<double>(1.0, 0.0), 
-                        [](std::complex<double> const &product_coefficient, std::complex<double> const &coefficient) -> std::complex<double> { 
-                            return product_coefficient * coefficient; 
-                        }, [](Scalar const &coefficient) -> std::complex<double> { 
-                            return coefficient->Value(); 
+                    // Reduce the factors to a single combined node via repeated MultiplicationNode nodes
+                    Scalar combined_factors = std::reduce(std::next(std::cbegin(variables)), std::cend(variables), variables.front(), 
+                        [](Scalar const &combined_factors, Scalar const &combined_factor) { 
+                            return Scalar(new MultiplicationNode({ combined_factors, combined_factor })); 
                         });
+                
+                    // Reduce the constants to a single value via repeated multiplication
+                    if (!constants.empty()) {
+                        std::complex<double> coefficient = std::transform_reduce(std::cbegin(constants), std::cend(constants), std::complex<double>(1.0, 0.0), 
+                            [](std::complex<double> const &product_coefficient, std::complex<double> const &coefficient) -> std::complex<double> { 
+                                return product_coefficient * coefficient; 
+                            }, [](Scalar const &coefficient) -> std::complex<double> { 
+                                return coefficient->Value(); 
+                            });
 
-                    return Scalar(new MultiplicationNode({ Scalar(new ConstantNode(coefficient)), combined_factors}));
-                }
-                else {
-                    return combined_factors;
+                        return Scalar(new MultiplicationNode({ Scalar(new ConstantNode(coefficient)), combined_factors}));
+                    }
+                    else {
+                        return combined_factors;
+                    }
                 }
             }
-        }
 
-        return scalar;
+            return scalar;
+        });
     }
 
     throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
@@ -399,149 +411,117 @@ std::variant<Scalar, Matrix> ExpressionSimplifier::CombineFactors(std::variant<S
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::CombineAddends()
 {
-    return Identify(CombineAddends(m_node_variant));
+    return Run("Identify", &ExpressionSimplifier::Identify, Run("CombineAddends", &ExpressionSimplifier::CombineAddends, m_node_variant));
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::CombineAddends(std::variant<Scalar, Matrix> const &node_variant)
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
+        return Map(std::get<Matrix>(node_variant), &ExpressionSimplifier::CombineAddends);
+    }
+    else if (std::holds_alternative<Scalar>(node_variant)) {
+        return Memoize(SimplificationCache::Pass::CombineAddends, std::get<Scalar>(node_variant), [this](Scalar scalar) -> Scalar {
+            if (scalar->Type() != "AdditionNode") {
+                std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::CombineAddends);
 
-        for (size_t i = 0; i < matrix.Rows(); ++i) {
-            for (size_t j = 0; j < matrix.Cols(); ++j) {
-                matrix(i, j) = std::get<Scalar>(CombineAddends(matrix(i, j)));
+                return Node::Rebuild(scalar, arguments);
             }
-        }
 
-        return matrix;
-    }
-    else if (std::holds_alternative<Scalar>(node_variant)) {
-        Scalar scalar = std::get<Scalar>(node_variant);
+            // The whole sum chain is combined at its top, so the sums nested in it are not collected again on the way down
+            std::vector<Scalar> addends = Addends(scalar);
 
-        for (auto &argument : scalar->Arguments()) {
-            argument = std::get<Scalar>(CombineAddends(argument));
-        }
+            std::transform(std::cbegin(addends), std::cend(addends), std::begin(addends), [this](Scalar const &addend) -> Scalar {
+                return std::get<Scalar>(CombineAddends(addend));
+            });
+
+            if (addends.size() > 0) {
+                struct Term
+                {
+                    Scalar addend;
+                    std::complex<double> coefficient;
+                    std::vector<Scalar> variables;
+                    size_t count;
+                };
 
-        std::vector<Scalar> addends = Addends(scalar);
+                std::vector<Term> terms;
+                std::unordered_map<size_t, size_t> monomials;
 
-        if (addends.size() > 0) {
-            // Assess addends with O(n*(n-1)/2) complexity
-            for (auto addend_lhs_it = std::begin(addends); addend_lhs_it != std::end(addends); ++addend_lhs_it) {
-                for (auto addend_rhs_it = std::next(addend_lhs_it); addend_rhs_it != std::end(addends); ++addend_rhs_it) {                
-                    // Extract the factors from the lhs addend and the rhs addend                
-                    auto lhs_factors = Factors(*addend_lhs_it);
-                    auto rhs_factors = Factors(*addend_rhs_it);
+                // Group the addends by the key of their variables, so like terms meet in one pass instead of pairwise
+                for (Scalar const &addend : addends) {
+                    std::vector<Scalar> factors = Factors(addend);
 
                     // Separate the factors into their constants and their variables
-                    std::vector<Scalar> lhs_constants;
-                    std::vector<Scalar> rhs_constants;
-
-                    std::vector<Scalar> lhs_variables;
-                    std::vector<Scalar> rhs_variables;
-
-                    std::partition_copy(std::cbegin(lhs_factors), std::cend(lhs_factors), std::back_inserter(lhs_constants), std::back_inserter(lhs_variables), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "ConstantNode"; });
-                    std::partition_copy(std::cbegin(rhs_factors), std::cend(rhs_factors), std::back_inserter(rhs_constants), std::back_inserter(rhs_variables), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "ConstantNode"; });
-
-                    if (lhs_variables.size() > 0 && lhs_variables.size() == rhs_variables.size()) {
-                        // Check if all of the variables are equivalent, std::equal will not work for this
-                        auto compare_variables = [](std::vector<Scalar> lhs_variables, std::vector<Scalar> rhs_variables) -> bool { 
-                            for (auto lhs_variable : lhs_variables) {
-                                auto rhs_variable_it = std::find_if(std::cbegin(rhs_variables), std::cend(rhs_variables), 
-                                    [&lhs_variable](Scalar const &rhs_variable) -> bool { 
-                                        return Node::Equivalent(lhs_variable, rhs_variable); 
-                                    });
-
-                                if (rhs_variable_it == std::cend(rhs_variables)) {
-                                    return false;
-                                }
-
-                                rhs_variables.erase(rhs_variable_it);
-                            }
-
-                            return true;
-                        };
-
-                        if (compare_variables(lhs_variables, rhs_variables)) {
-                            // If there are multiple constants per term, multiply them together and increment the coefficient                    
-                            std::complex<double> coefficient;
-                            
-                            if (lhs_constants.empty()) {
-                                coefficient += std::complex<double>(1.0, 0.0);
-                            }
-                            else {
-                                coefficient += std::transform_reduce(std::cbegin(lhs_constants), std::cend(lhs_constants), std::complex<double>(1.0, 0.0), 
-                                    [](std::complex<double> const &product_coefficient, std::complex<double> const &coefficient) -> std::complex<double> { 
-                                        return product_coefficient * coefficient; 
-                                    }, [](Scalar const &lhs_coefficient) -> std::complex<double> { 
-                                        return lhs_coefficient->Value(); 
-                                    });
-                            }
-
-                            if (rhs_constants.empty()) {
-                                coefficient += std::complex<double>(1.0, 0.0);
-                            }
-                            else {
-                                coefficient += std::transform_reduce(std::cbegin(rhs_constants), std::cend(rhs_constants), std::complex<double>(1.0, 0.0), 
-                                    [](std::complex<double> const &product_coefficient, std::complex<double> const &coefficient) -> std::complex<double> { 
-                                        return product_coefficient * coefficient; 
-                                    }, [](Scalar const &rhs_coefficient) -> std::complex<double> { 
-                                        return rhs_coefficient->Value(); 
-                                    });
-                            }
-
-                            // Recombining the variables via repeated MultiplicationNode
-                            Scalar combined_variables = std::reduce(std::next(std::cbegin(lhs_variables)), std::cend(lhs_variables), lhs_variables.front(), 
-                                [](Scalar const &combined_variables, Scalar const &combined_variable) -> Scalar { 
-                                    return Scalar(new MultiplicationNode({ combined_variables, combined_variable })); 
-                                });
+                    std::vector<Scalar> constants;
+                    std::vector<Scalar> variables;
 
-                            // Multiply by the coefficient
-                            *addend_lhs_it = Scalar(new MultiplicationNode({ std::shared_ptr<ConstantNode>(new ConstantNode(coefficient)), combined_variables }));
+                    std::partition_copy(std::cbegin(factors), std::cend(factors), std::back_inserter(constants), std::back_inserter(variables), [](Scalar const &factor_ptr) -> bool { return factor_ptr->Type() == "ConstantNode"; });
 
-                            // Remove the old term
-                            addend_rhs_it = addends.erase(addend_rhs_it);
+                    // If there are multiple constants per term, multiply them together
+                    std::complex<double> coefficient = std::transform_reduce(std::cbegin(constants), std::cend(constants), std::complex<double>(1.0, 0.0),
+                        [](std::complex<double> const &product_coefficient, std::complex<double> const &coefficient) -> std::complex<double> {
+                            return product_coefficient * coefficient;
+                        }, [](Scalar const &constant) -> std::complex<double> {
+                            return constant->Value();
+                        });
 
-                            // Make sure we don't segfault by attempting to access out-of-bounds memory!
-                            if (addend_rhs_it == std::end(addends)) {
-                                break;
-                            }
-                        }
+                    // The monomial key is the sorted multiset of variable keys, constant terms all share the empty monomial
+                    std::vector<size_t> variable_keys;
+
+                    std::transform(std::cbegin(variables), std::cend(variables), std::back_inserter(variable_keys), [this](Scalar const &variable) -> size_t { return Key(variable); });
+                    std::sort(std::begin(variable_keys), std::end(variable_keys));
+
+                    std::ostringstream monomial;
+
+                    monomial << "Monomial";
+
+                    for (size_t const &variable_key : variable_keys) {
+                        monomial << ':' << variable_key;
                     }
-                    else if (lhs_constants.size() > 0 && rhs_constants.size() > 0 && lhs_variables.size() == 0 && rhs_variables.size() == 0) {
-                        // Sum the constants
-                        std::complex<double> combined_constants;
-                        
-                        for (auto lhs_constant : lhs_constants) {
-                            combined_constants += lhs_constant->Value();
-                        }
 
-                        for (auto rhs_constant : rhs_constants) {
-                            combined_constants += rhs_constant->Value();
-                        }
+                    auto const [monomial_it, inserted] = monomials.emplace(Key(monomial.str()), terms.size());
+
+                    if (inserted) {
+                        terms.push_back({ addend, coefficient, variables, 1 });
+                    }
+                    else {
+                        terms[monomial_it->second].coefficient += coefficient;
+                        terms[monomial_it->second].count += 1;
+                    }
+                }
 
-                        *addend_lhs_it = Scalar(new ConstantNode(combined_constants));
+                addends.clear();
 
-                        // Remove the old term
-                        addend_rhs_it = addends.erase(addend_rhs_it);
+                for (Term const &term : terms) {
+                    if (term.count == 1) {
+                        addends.push_back(term.addend);
+                    }
+                    else if (term.variables.empty()) {
+                        // Sum the constants
+                        addends.push_back(Scalar(new ConstantNode(term.coefficient)));
+                    }
+                    else {
+                        // Recombining the variables via repeated MultiplicationNode
+                        Scalar combined_variables = std::reduce(std::next(std::cbegin(term.variables)), std::cend(term.variables), term.variables.front(),
+                            [](Scalar const &combined_variables, Scalar const &combined_variable) -> Scalar {
+                                return Scalar(new MultiplicationNode({ combined_variables, combined_variable }));
+                            });
 
-                        // Make sure we don't segfault by attempting to access out-of-bounds memory!
-                        if (addend_rhs_it == std::end(addends)) {
-                            break;
-                        }
+                        // Multiply by the coefficient
+                        addends.push_back(Scalar(new MultiplicationNode({ Scalar(new ConstantNode(term.coefficient)), combined_variables })));
                     }
                 }
-            }
 
-            // Sum the addends for the final result
-            Scalar combined_addends = std::reduce(std::next(std::cbegin(addends)), std::cend(addends), addends.front(), 
-                [](Scalar const &combined_addends, Scalar const &combined_addend) { 
-                    return Scalar(new AdditionNode({ combined_addends, combined_addend })); 
-                });
+                // Sum the addends for the final result
+                Scalar combined_addends = std::reduce(std::next(std::cbegin(addends)), std::cend(addends), addends.front(), 
+                    [](Scalar const &combined_addends, Scalar const &combined_addend) { 
+                        return Scalar(new AdditionNode({ combined_addends, combined_addend })); 
+                    });
 
-            return combined_addends;
-        }
+                return combined_addends;
+            }
 
-        return scalar;
+            return scalar;
+        });
     }
 
     throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
@@ -549,97 +529,602 @@ std::variant<Scalar, Matrix> ExpressionSimplifier::CombineAddends(std::variant<S
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Factorize()
 {
-    return Identify(Factorize(m_node_variant));
+    return Run("Identify", &ExpressionSimplifier::Identify, Run("Factorize", &ExpressionSimplifier::Factorize, m_node_variant));
 }
 
 std::variant<Scalar, Matrix> ExpressionSimplifier::Factorize(std::variant<Scalar, Matrix> const &node_variant)
 {
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
-
-        for (size_t i = 0; i < matrix.Rows(); ++i) {
-            for (size_t j = 0; j < matrix.Cols(); ++j) {
-                matrix(i, j) = std::get<Scalar>(Factorize(matrix(i, j)));
-            }
-        }
-
-        return matrix;
+        return Map(std::get<Matrix>(node_variant), &ExpressionSimplifier::Factorize);
     }
     else if (std::holds_alternative<Scalar>(node_variant)) {
-        Scalar scalar = std::get<Scalar>(node_variant);
+        return Memoize(SimplificationCache::Pass::Factorize, std::get<Scalar>(node_variant), [this](Scalar scalar) -> Scalar {
+            std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::Factorize);
 
-        for (auto &argument : scalar->Arguments()) {
-            argument = std::get<Scalar>(Factorize(argument));
-        }
+            scalar = Node::Rebuild(scalar, arguments);
 
-        // [ 2*w*x, 2*w*y, 2*w*z ]
-        std::vector<Scalar> addends = Addends(scalar);
+            // [ 2*w*x, 2*w*y, 2*w*z ]
+            std::vector<Scalar> addends = Addends(scalar);
 
-        // [ [ 2, w, x ], [ 2, w, y ], [ 2, w, z ] ]
-        std::vector<std::vector<Scalar>> factors_of_addends;
+            if (addends.size() > 1) {
+                // Kind first, then the structural order, so the common factors come out the same whatever was simplified before
+                auto precedes = [this](Scalar const &lhs, Scalar const &rhs) -> bool {
+                    return Precedes(lhs, rhs);
+                };
 
-        std::transform(std::cbegin(addends), std::cend(addends), std::back_inserter(factors_of_addends), 
-            [](Scalar const &addend_ptr) -> std::vector<Scalar> { 
-                return Factors(addend_ptr);
-            });
+                // [ [ 2, w, x ], [ 2, w, y ], [ 2, w, z ] ], each sorted so that products compare as multisets
+                std::vector<std::vector<Scalar>> factors_of_addends;
 
-        if (factors_of_addends.size() > 1) {
-            // [ 2, w, x ] ∩ [ 2, w, y ] ∩ [ 2, w, z ] = [ 2, w ]
-            std::vector<Scalar> common_factors = std::reduce(std::next(std::cbegin(factors_of_addends)), std::cend(factors_of_addends), factors_of_addends.front(), 
-                [](std::vector<Scalar> const &common_factors, std::vector<Scalar> const &factors) -> std::vector<Scalar> {
+                for (Scalar const &addend : addends) {
+                    std::vector<Scalar> factors = Factors(addend);
+
+                    std::sort(std::begin(factors), std::end(factors), precedes);
+
+                    factors_of_addends.push_back(std::move(factors));
+                }
+
+                // [ 2, w, x ] ∩ [ 2, w, y ] ∩ [ 2, w, z ] = [ 2, w ], one linear merge per addend
+                std::vector<Scalar> common_factors = factors_of_addends.front();
+
+                for (auto factors_it = std::next(std::cbegin(factors_of_addends)); factors_it != std::cend(factors_of_addends) && !common_factors.empty(); ++factors_it) {
                     std::vector<Scalar> factors_intersection;
-                    
-                    std::set_intersection(std::cbegin(factors), std::cend(factors), std::cbegin(common_factors), std::cend(common_factors), std::back_inserter(factors_intersection), 
-                        [](Scalar const &lhs_ptr, Scalar const &rhs_ptr) -> bool { 
-                            return !Node::Equivalent(lhs_ptr, rhs_ptr); 
-                        });
 
-                    return factors_intersection;
-                });
+                    std::set_intersection(std::cbegin(common_factors), std::cend(common_factors), std::cbegin(*factors_it), std::cend(*factors_it), std::back_inserter(factors_intersection), precedes);
 
-            if (common_factors.size() > 0) {
-                // [ 2, w, x ] - [ 2, w ] = [ x ] ...
-                // [ 2, w, y ] - [ 2, w ] = [ x, y ] ...
-                // [ 2, w, z ] - [ 2, w ] = [ x, y, z ]
-                std::vector<Scalar> uncommon_factors = std::reduce(std::cbegin(factors_of_addends), std::cend(factors_of_addends), std::vector<Scalar>(),
-                    [&common_factors](std::vector<Scalar> const &uncommon_factors, std::vector<Scalar> const &factors) -> std::vector<Scalar> {
+                    common_factors = std::move(factors_intersection);
+                }
+
+                if (!common_factors.empty()) {
+                    // [ 2, w, x ] - [ 2, w ] = x, [ 2, w, y ] - [ 2, w ] = y, [ 2, w, z ] - [ 2, w ] = z
+                    std::vector<Scalar> remainders;
+
+                    for (std::vector<Scalar> const &factors : factors_of_addends) {
                         std::vector<Scalar> factors_difference;
-                        
-                        std::set_difference(std::cbegin(factors), std::cend(factors), std::cbegin(common_factors), std::cend(common_factors), std::back_inserter(factors_difference), 
-                            [](Scalar const &lhs_ptr, Scalar const &rhs_ptr) -> bool { 
-                                return !Node::Equivalent(lhs_ptr, rhs_ptr); 
-                            });
 
-                        std::copy(std::cbegin(uncommon_factors), std::cend(uncommon_factors), std::back_inserter(factors_difference));
+                        std::set_difference(std::cbegin(factors), std::cend(factors), std::cbegin(common_factors), std::cend(common_factors), std::back_inserter(factors_difference), precedes);
 
-                        return factors_difference;
-                    });
+                        // An addend made only of common factors leaves 1 behind
+                        Scalar remainder = factors_difference.empty() ? Scalar(new ConstantNode(1.0)) : factors_difference.front();
+
+                        for (auto factor_it = std::next(std::cbegin(factors_difference)); factor_it < std::cend(factors_difference); ++factor_it) {
+                            remainder = Scalar(new MultiplicationNode({ remainder, *factor_it }));
+                        }
+
+                        remainders.push_back(remainder);
+                    }
 
-                if (uncommon_factors.size() > 0) {
                     // [ 2, w ] = 2*w
-                    Scalar common_factors_ptr = std::reduce(std::next(std::cbegin(common_factors)), std::cend(common_factors), common_factors.front(), 
+                    Scalar common_factors_ptr = std::accumulate(std::next(std::cbegin(common_factors)), std::cend(common_factors), common_factors.front(), 
                         [](Scalar const &common_factors_ptr, Scalar const &common_factor) -> Scalar { 
                             return Scalar(new MultiplicationNode({ common_factors_ptr, common_factor }));
                         });
 
                     // [ x, y, z ] = x+y+z
-                    Scalar uncommon_factors_ptr = std::reduce(std::next(std::cbegin(uncommon_factors)), std::cend(uncommon_factors), uncommon_factors.front(), 
-                        [](Scalar const &uncommon_factors_ptr, Scalar const &uncommon_factor) -> Scalar { 
-                            return Scalar(new AdditionNode({ uncommon_factors_ptr, uncommon_factor }));
+                    Scalar remainders_ptr = std::reduce(std::next(std::cbegin(remainders)), std::cend(remainders), remainders.front(), 
+                        [](Scalar const &remainders_ptr, Scalar const &remainder) -> Scalar { 
+                            return Scalar(new AdditionNode({ remainders_ptr, remainder }));
                         });
 
                     return Scalar(new MultiplicationNode({
                         common_factors_ptr,
-                        uncommon_factors_ptr
+                        remainders_ptr
                     }));
                 }
             }
+
+            return scalar;
+        });
+    }
+
+    throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
+}
+
+std::variant<Scalar, Matrix> ExpressionSimplifier::Saturate(std::chrono::milliseconds const &time_budget, size_t const &node_budget)
+{
+    return Saturate(m_node_variant, time_budget, node_budget);
+}
+
+std::variant<Scalar, Matrix> ExpressionSimplifier::Saturate(std::variant<Scalar, Matrix> const &node_variant, std::chrono::milliseconds const &time_budget, size_t const &node_budget)
+{
+    if (std::holds_alternative<Matrix>(node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(node_variant);
+
+        std::vector<Scalar> elements(matrix.Rows() * matrix.Cols());
+
+        // Each element gets its own graph and budget
+        Parallel(elements.size(), [&matrix, &elements, &time_budget, &node_budget](ExpressionSimplifier &simplifier, size_t const &index) {
+            elements[index] = std::get<Scalar>(simplifier.Saturate(matrix(index / matrix.Cols(), index % matrix.Cols()), time_budget, node_budget));
+        });
+
+        return Matrix(matrix.Rows(), matrix.Cols(), elements);
+    }
+    else if (std::holds_alternative<Scalar>(node_variant)) {
+        EGraph graph;
+
+        EGraph::Id const root = graph.Add(std::get<Scalar>(node_variant));
+
+        // An exhausted budget still leaves every rewrite found so far in the graph, so extraction is valid either way
+        graph.Saturate(time_budget, node_budget);
+
+        return graph.Extract(root);
+    }
+
+    throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
+}
+
+bool ExpressionSimplifier::Expandable(Scalar const &scalar)
+{
+    std::string const type = scalar->Type();
+
+    return type == "AdditionNode" || type == "SubtractionNode" || type == "MultiplicationNode" || type == "DivisionNode" || type == "ExponentiationNode";
+}
+
+Polynomial ExpressionSimplifier::Expand(Scalar const &scalar, std::vector<Scalar> &atoms, std::unordered_map<size_t, size_t> &indices)
+{
+    // Once the budget is spent the rest of the subtree is kept whole as an atom
+    if (Exhausted()) {
+        return Atom(scalar, atoms, indices);
+    }
+    else if (scalar->Type() == "ConstantNode") {
+        return Polynomial(scalar->Value());
+    }
+    else if (scalar->Type() == "AdditionNode") {
+        // The left expansion is owned here, so the right one is added into it instead of both being copied into a new sum
+        Polynomial sum = Expand(scalar->Argument(0), atoms, indices);
+
+        sum.Accumulate(Expand(scalar->Argument(1), atoms, indices));
+
+        return sum;
+    }
+    else if (scalar->Type() == "SubtractionNode") {
+        Polynomial difference = Expand(scalar->Argument(0), atoms, indices);
+
+        difference.Accumulate(Expand(scalar->Argument(1), atoms, indices), -1.0);
+
+        return difference;
+    }
+    else if (scalar->Type() == "MultiplicationNode") {
+        try {
+            return Expand(scalar->Argument(0), atoms, indices).Multiply(Expand(scalar->Argument(1), atoms, indices), std::min(Polynomial::max_terms, m_budget.nodes));
+        }
+        catch (std::length_error const &) {
+            // Too many terms to expand, the product is kept as an atom
+            m_truncated = m_truncated || m_budget.nodes < Polynomial::max_terms;
+        }
+    }
+    else if (scalar->Type() == "DivisionNode" && scalar->Argument(1)->Type() == "ConstantNode" && !Node::Zero(scalar->Argument(1))) {
+        return Expand(scalar->Argument(0), atoms, indices).Scale(1.0 / scalar->Argument(1)->Value());
+    }
+    else if (scalar->Type() == "ExponentiationNode" && scalar->Argument(1)->Type() == "ConstantNode" && Polynomial::Natural(scalar->Argument(1)->Value())) {
+        try {
+            return Expand(scalar->Argument(0), atoms, indices).Pow(static_cast<uint32_t>(std::round(scalar->Argument(1)->Value().real())), std::min(Polynomial::max_terms, m_budget.nodes));
+        }
+        catch (std::length_error const &) {
+            // Too many terms to expand, the power is kept as an atom
+            m_truncated = m_truncated || m_budget.nodes < Polynomial::max_terms;
+        }
+    }
+
+    // Anything else is an atom of the polynomial
+    return Atom(scalar, atoms, indices);
+}
+
+Polynomial ExpressionSimplifier::Atom(Scalar const &scalar, std::vector<Scalar> &atoms, std::unordered_map<size_t, size_t> &indices)
+{
+    // The arguments of an atom are distributed independently
+    std::vector<Scalar> arguments = Arguments(scalar, &ExpressionSimplifier::Distribute);
+
+    Scalar atom = Node::Rebuild(scalar, arguments);
+
+    auto const [index_it, inserted] = indices.emplace(Key(atom), atoms.size());
+
+    if (inserted) {
+        atoms.push_back(atom);
+    }
+
+    return Polynomial::Variable(index_it->second);
+}
+
+Scalar ExpressionSimplifier::Collect(Polynomial const &polynomial, std::vector<Scalar> const &atoms)
+{
+    std::vector<Scalar> addends;
+
+    // Reverse lexicographic order of the exponent vectors, so x^2 comes before x*y, before x, before y^2
+    for (auto term_it = polynomial.Coefficients().crbegin(); term_it != polynomial.Coefficients().crend(); ++term_it) {
+        auto const &[monomial, coefficient] = *term_it;
+
+        std::vector<Scalar> factors;
+
+        for (auto const &[index, exponent] : monomial) {
+            if (exponent == 1) {
+                factors.push_back(atoms[index]);
+            }
+            else {
+                factors.push_back(Scalar(new ExponentiationNode({ atoms[index], Scalar(new ConstantNode(static_cast<double>(exponent))) })));
+            }
+        }
+
+        if (factors.empty()) {
+            addends.push_back(Scalar(new ConstantNode(coefficient)));
+
+            continue;
+        }
+
+        Scalar combined_factors = std::reduce(std::next(std::cbegin(factors)), std::cend(factors), factors.front(),
+            [](Scalar const &combined_factors, Scalar const &combined_factor) -> Scalar {
+                return Scalar(new MultiplicationNode({ combined_factors, combined_factor }));
+            });
+
+        if (Approximately(coefficient, 1.0)) {
+            addends.push_back(combined_factors);
         }
+        else {
+            addends.push_back(Scalar(new MultiplicationNode({ Scalar(new ConstantNode(coefficient)), combined_factors })));
+        }
+    }
 
+    if (addends.empty()) {
+        return Scalar(new ConstantNode(0.0));
+    }
+
+    return std::reduce(std::next(std::cbegin(addends)), std::cend(addends), addends.front(),
+        [](Scalar const &combined_addends, Scalar const &combined_addend) -> Scalar {
+            return Scalar(new AdditionNode({ combined_addends, combined_addend }));
+        });
+}
+
+Matrix ExpressionSimplifier::Map(Matrix const &matrix, Pass const &pass)
+{
+    std::vector<Scalar> elements(matrix.Rows() * matrix.Cols());
+
+    Parallel(elements.size(), [&matrix, &pass, &elements](ExpressionSimplifier &simplifier, size_t const &index) {
+        elements[index] = std::get<Scalar>((simplifier.*pass)(matrix(index / matrix.Cols(), index % matrix.Cols())));
+    });
+
+    return Matrix(matrix.Rows(), matrix.Cols(), elements);
+}
+
+std::vector<Scalar> ExpressionSimplifier::Arguments(Scalar const &scalar, Pass const &pass)
+{
+    std::vector<Scalar> const &inputs = scalar->Arguments();
+    std::vector<Scalar> arguments(inputs.size());
+
+    ++m_depth;
+
+    // Only the top of the tree is split, deeper down the size checks would cost more than they could save
+    bool const parallel = m_depth <= max_parallel_depth && inputs.size() > 1 && std::all_of(std::cbegin(inputs), std::cend(inputs), [](Scalar const &input) -> bool { return Size(input, min_parallel_nodes) >= min_parallel_nodes; });
+
+    if (parallel) {
+        Parallel(inputs.size(), [&inputs, &pass, &arguments](ExpressionSimplifier &simplifier, size_t const &index) {
+            arguments[index] = std::get<Scalar>((simplifier.*pass)(inputs[index]));
+        });
+    }
+    else {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            arguments[i] = std::get<Scalar>((this->*pass)(inputs[i]));
+        }
+    }
+
+    --m_depth;
+
+    return arguments;
+}
+
+void ExpressionSimplifier::Parallel(size_t const &count, std::function<void(ExpressionSimplifier &, size_t const &)> const &body)
+{
+    std::mutex mutex;
+
+    bool const truncated = m_truncated;
+
+    // Every chunk works on its own simplifier, which shares the cache and the budget but not the keys and hashes
+    ThreadPool::Default().ParallelFor(count, [this, &body, &mutex, &truncated](size_t const &begin, size_t const &end) {
+        ExpressionSimplifier simplifier(m_node_variant, { }, m_cache);
+
+        simplifier.m_budget = m_budget;
+        simplifier.m_start = m_start;
+        simplifier.m_rewrites = m_rewrites;
+        simplifier.m_truncated = truncated;
+        simplifier.m_depth = m_depth;
+        simplifier.m_statistics = m_statistics ? std::make_shared<SimplificationStatistics>() : nullptr;
+
+        for (size_t i = begin; i < end; ++i) {
+            body(simplifier, i);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        m_truncated = m_truncated || simplifier.m_truncated;
+
+        if (m_statistics) {
+            m_statistics->Merge(*simplifier.m_statistics);
+        }
+    });
+}
+
+std::variant<Scalar, Matrix> ExpressionSimplifier::Run(std::string const &name, Pass const &pass, std::variant<Scalar, Matrix> const &node_variant)
+{
+    if (!m_statistics) {
+        return (this->*pass)(node_variant);
+    }
+
+    size_t const nodes_in = Size(node_variant);
+
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+    std::variant<Scalar, Matrix> result = (this->*pass)(node_variant);
+
+    m_statistics->Record(name, nodes_in, Size(result), std::chrono::steady_clock::now() - start);
+
+    return result;
+}
+
+Scalar ExpressionSimplifier::Fired(char const *rule, Scalar const &scalar)
+{
+    if (m_statistics) {
+        m_statistics->rules[rule] += 1;
+    }
+
+    return scalar;
+}
+
+bool ExpressionSimplifier::Exhausted()
+{
+    if (!m_truncated) {
+        m_truncated = *m_rewrites >= m_budget.rewrites || std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start) >= m_budget.time;
+    }
+
+    return m_truncated;
+}
+
+size_t ExpressionSimplifier::Size(std::variant<Scalar, Matrix> const &node_variant, size_t const &limit)
+{
+    std::unordered_set<Node const *> visited;
+    std::vector<Scalar> pending;
+
+    if (std::holds_alternative<Matrix>(node_variant)) {
+        Matrix const &matrix = std::get<Matrix>(node_variant);
+
+        for (size_t i = 0; i < matrix.Rows(); ++i) {
+            for (size_t j = 0; j < matrix.Cols(); ++j) {
+                pending.push_back(matrix(i, j));
+            }
+        }
+    }
+    else if (std::holds_alternative<Scalar>(node_variant)) {
+        pending.push_back(std::get<Scalar>(node_variant));
+    }
+
+    // Shared subtrees are counted once, since that is what they cost in memory
+    while (!pending.empty() && visited.size() < limit) {
+        Scalar scalar = pending.back();
+
+        pending.pop_back();
+
+        if (visited.insert(scalar.get()).second) {
+            for (Scalar const &argument : scalar->Arguments()) {
+                pending.push_back(argument);
+            }
+        }
+    }
+
+    return visited.size();
+}
+
+Scalar ExpressionSimplifier::Memoize(SimplificationCache::Pass const &pass, Scalar const &scalar, std::function<Scalar(Scalar)> const &rewrite)
+{
+    // Once the budget is spent the remaining subtrees are left as they are, which is still an equivalent expression
+    if (Exhausted()) {
         return scalar;
     }
 
-    throw std::invalid_argument("std::variant<Scalar, Matrix> holds neither");
+    // Leaves are cheaper to rewrite than to look up
+    if (!m_cache || scalar->Arguments().empty()) {
+        Scalar rewritten = rewrite(scalar);
+
+        // Rewrites count against the budget whether or not they are cached
+        if (rewritten != scalar) {
+            ++*m_rewrites;
+        }
+
+        return rewritten;
+    }
+
+    size_t const hash = Hash(scalar);
+
+    Scalar cached = m_cache->Find(pass, hash, scalar);
+
+    if (m_statistics) {
+        ++(cached ? m_statistics->cache_hits : m_statistics->cache_misses);
+    }
+
+    if (cached) {
+        return cached;
+    }
+
+    Scalar rewritten = rewrite(scalar);
+
+    if (rewritten != scalar) {
+        ++*m_rewrites;
+    }
+
+    // A rewrite cut short by the budget is not the full rewrite, so it is not remembered
+    if (!m_truncated) {
+        m_cache->Insert(pass, hash, scalar, rewritten);
+    }
+
+    return rewritten;
+}
+
+size_t ExpressionSimplifier::Hash(Scalar const &scalar)
+{
+    auto hash_it = m_hashes.find(scalar);
+
+    if (hash_it != std::end(m_hashes)) {
+        return hash_it->second;
+    }
+
+    size_t hash = std::hash<std::string>()(scalar->Type());
+
+    auto combine = [&hash](size_t const &value) {
+        hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    };
+
+    if (scalar->Type() == "ConstantNode") {
+        combine(std::hash<double>()(scalar->Value().real()));
+        combine(std::hash<double>()(scalar->Value().imag()));
+    }
+    else if (scalar->Arguments().empty()) {
+        combine(std::hash<Node const *>()(scalar.get()));
+    }
+    else {
+        for (Scalar const &argument : scalar->Arguments()) {
+            combine(Hash(argument));
+        }
+    }
+
+    m_hashes.emplace(scalar, hash);
+
+    return hash;
+}
+
+size_t ExpressionSimplifier::Key(Scalar const &scalar)
+{
+    auto key_it = m_node_keys.find(scalar);
+
+    if (key_it != std::end(m_node_keys)) {
+        return key_it->second;
+    }
+
+    std::ostringstream key;
+
+    key << scalar->Type();
+
+    if (scalar->Type() == "ConstantNode") {
+        // Constants are rounded to the tolerance of Approximately so that nearly equal values share a key
+        std::complex<double> const value = scalar->Value();
+
+        key << std::setprecision(17) << ':' << std::round(value.real() / key_epsilon) << ':' << std::round(value.imag() / key_epsilon);
+    }
+    else if (scalar->Arguments().empty()) {
+        // Variables are distinguished by identity
+        key << ':' << scalar.get();
+    }
+    else {
+        std::vector<size_t> argument_keys;
+
+        for (Scalar const &argument : scalar->Arguments()) {
+            argument_keys.push_back(Key(argument));
+        }
+
+        // Only addition and multiplication ignore the order of their arguments
+        if (scalar->Type() == "AdditionNode" || scalar->Type() == "MultiplicationNode") {
+            std::sort(std::begin(argument_keys), std::end(argument_keys));
+        }
+
+        for (size_t const &argument_key : argument_keys) {
+            key << ':' << argument_key;
+        }
+    }
+
+    size_t const key_id = Key(key.str());
+
+    m_node_keys.emplace(scalar, key_id);
+
+    return key_id;
+}
+
+size_t ExpressionSimplifier::Key(std::string const &key_str)
+{
+    return m_keys.emplace(key_str, m_keys.size()).first->second;
+}
+
+size_t ExpressionSimplifier::Order(Scalar const &scalar)
+{
+    auto order_it = m_orders.find(scalar);
+
+    if (order_it != std::end(m_orders)) {
+        return order_it->second;
+    }
+
+    size_t order = std::hash<std::string>()(scalar->Type());
+
+    auto combine = [&order](size_t const &value) {
+        order ^= value + 0x9e3779b97f4a7c15 + (order << 6) + (order >> 2);
+    };
+
+    if (scalar->Type() == "ConstantNode") {
+        // Rounded like keys, so that constants sharing a key also share an order
+        std::complex<double> const value = scalar->Value();
+
+        combine(std::hash<double>()(std::round(value.real() / key_epsilon)));
+        combine(std::hash<double>()(std::round(value.imag() / key_epsilon)));
+    }
+    else if (scalar->Arguments().empty()) {
+        combine(std::hash<Node const *>()(scalar.get()));
+    }
+    else {
+        std::vector<size_t> argument_orders;
+
+        for (Scalar const &argument : scalar->Arguments()) {
+            argument_orders.push_back(Order(argument));
+        }
+
+        // Only addition and multiplication ignore the order of their arguments
+        if (scalar->Type() == "AdditionNode" || scalar->Type() == "MultiplicationNode") {
+            std::sort(std::begin(argument_orders), std::end(argument_orders));
+        }
+
+        for (size_t const &argument_order : argument_orders) {
+            combine(argument_order);
+        }
+    }
+
+    m_orders.emplace(scalar, order);
+
+    return order;
+}
+
+bool ExpressionSimplifier::Precedes(Scalar const &lhs, Scalar const &rhs)
+{
+    if (lhs->Type() != rhs->Type()) {
+        return lhs->Type() < rhs->Type();
+    }
+    else if (Order(lhs) != Order(rhs)) {
+        return Order(lhs) < Order(rhs);
+    }
+    else if (lhs->Type() == "ConstantNode") {
+        std::complex<double> const lhs_value = lhs->Value();
+        std::complex<double> const rhs_value = rhs->Value();
+
+        return std::make_tuple(std::round(lhs_value.real() / key_epsilon), std::round(lhs_value.imag() / key_epsilon)) < std::make_tuple(std::round(rhs_value.real() / key_epsilon), std::round(rhs_value.imag() / key_epsilon));
+    }
+    else if (lhs->Arguments().empty() || rhs->Arguments().empty()) {
+        return std::less<Node const *>()(lhs.get(), rhs.get());
+    }
+
+    // Equal orders of different subtrees are rare, so only then are the arguments compared one by one
+    std::vector<Scalar> lhs_arguments = lhs->Arguments();
+    std::vector<Scalar> rhs_arguments = rhs->Arguments();
+
+    if (lhs->Type() == "AdditionNode" || lhs->Type() == "MultiplicationNode") {
+        auto precedes = [this](Scalar const &lhs, Scalar const &rhs) -> bool {
+            return Precedes(lhs, rhs);
+        };
+
+        std::sort(std::begin(lhs_arguments), std::end(lhs_arguments), precedes);
+        std::sort(std::begin(rhs_arguments), std::end(rhs_arguments), precedes);
+    }
+
+    for (size_t i = 0; i < lhs_arguments.size() && i < rhs_arguments.size(); ++i) {
+        if (Precedes(lhs_arguments[i], rhs_arguments[i])) {
+            return true;
+        }
+        else if (Precedes(rhs_arguments[i], lhs_arguments[i])) {
+            return false;
+        }
+    }
+
+    return lhs_arguments.size() < rhs_arguments.size();
 }
 
 std::vector<Scalar> ExpressionSimplifier::Factors(Scalar const &node_scalar)
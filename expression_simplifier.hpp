@@ -7,10 +7,20 @@
 #include <memory>
 #include <string>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <atomic>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 #include <functional>
+#include <tuple>
 
 #include "node.hpp"
 
@@ -18,21 +28,70 @@
 #include "operations.hpp"
 #include "functions.hpp"
 #include "utils.hpp"
+#include "e_graph.hpp"
+#include "polynomial.hpp"
+#include "simplification_cache.hpp"
+#include "simplification_statistics.hpp"
 
 class ExpressionSimplifier
 {
+public:
+    // Simplify stops once any limit is reached and returns the smallest expression found so far
+    struct Budget
+    {
+        std::chrono::milliseconds time = std::chrono::milliseconds::max();
+        size_t rewrites = std::numeric_limits<size_t>::max();
+        size_t nodes = std::numeric_limits<size_t>::max();
+    };
+
+private:
     std::variant<Scalar, Matrix> m_node_variant;
     std::map<std::string, std::variant<Scalar, Matrix>> m_node_map;
 
+    // Structurally equal subtrees are interned to the same key, so like terms are grouped by hashing instead of pairwise comparison
+    std::unordered_map<std::string, size_t> m_keys;
+    std::unordered_map<Scalar, size_t> m_node_keys;
+
+    // Rewritten subtrees are shared across simplifiers through the cache, hashes are only remembered for this one
+    std::shared_ptr<SimplificationCache> m_cache;
+    std::unordered_map<Scalar, size_t> m_hashes;
+
+    // Orders depend only on the subtree, unlike keys, which are numbered in the order they are first met
+    std::unordered_map<Scalar, size_t> m_orders;
+
+    Budget m_budget;
+    std::chrono::steady_clock::time_point m_start;
+
+    // Forked simplifiers count into the same rewrites, so the budget holds across all of them together
+    std::shared_ptr<std::atomic<size_t>> m_rewrites;
+    bool m_truncated;
+
+    size_t m_depth;
+
+    // Only collected when instrumented, every record is guarded by a null check
+    std::shared_ptr<SimplificationStatistics> m_statistics;
+
+    using Pass = std::variant<Scalar, Matrix> (ExpressionSimplifier::*)(std::variant<Scalar, Matrix> const &);
+
+    static constexpr double key_epsilon = 1e-9;
+
 public:
-    ExpressionSimplifier(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map = { });
+    static constexpr size_t min_parallel_nodes = 256;
+    static constexpr size_t max_parallel_depth = 4;
+
+    ExpressionSimplifier(std::variant<Scalar, Matrix> const &node_variant, std::map<std::string, std::variant<Scalar, Matrix>> const &node_map = { }, std::shared_ptr<SimplificationCache> const &cache = SimplificationCache::default_cache);
 
     std::variant<Scalar, Matrix> Simplify();
+    std::variant<Scalar, Matrix> Simplify(Budget const &budget);
+    bool Truncated() const;
+
+    void Instrument(std::shared_ptr<SimplificationStatistics> const &statistics);
     std::variant<Scalar, Matrix> Identify();
     std::variant<Scalar, Matrix> Distribute();
     std::variant<Scalar, Matrix> CombineFactors();
     std::variant<Scalar, Matrix> CombineAddends();
     std::variant<Scalar, Matrix> Factorize();
+    std::variant<Scalar, Matrix> Saturate(std::chrono::milliseconds const &time_budget = EGraph::default_time_budget, size_t const &node_budget = EGraph::default_node_budget);
 
 private:
     std::variant<Scalar, Matrix> Identify(std::variant<Scalar, Matrix> const &node_variant);
@@ -40,6 +99,32 @@ private:
     std::variant<Scalar, Matrix> CombineFactors(std::variant<Scalar, Matrix> const &node_variant);
     std::variant<Scalar, Matrix> CombineAddends(std::variant<Scalar, Matrix> const &node_variant);
     std::variant<Scalar, Matrix> Factorize(std::variant<Scalar, Matrix> const &node_variant);
+    std::variant<Scalar, Matrix> Saturate(std::variant<Scalar, Matrix> const &node_variant, std::chrono::milliseconds const &time_budget, size_t const &node_budget);
+
+    static bool Expandable(Scalar const &scalar);
+
+    Polynomial Expand(Scalar const &scalar, std::vector<Scalar> &atoms, std::unordered_map<size_t, size_t> &indices);
+    Polynomial Atom(Scalar const &scalar, std::vector<Scalar> &atoms, std::unordered_map<size_t, size_t> &indices);
+    static Scalar Collect(Polynomial const &polynomial, std::vector<Scalar> const &atoms);
+
+    std::variant<Scalar, Matrix> Run(std::string const &name, Pass const &pass, std::variant<Scalar, Matrix> const &node_variant);
+    Scalar Fired(char const *rule, Scalar const &scalar);
+
+    bool Exhausted();
+    static size_t Size(std::variant<Scalar, Matrix> const &node_variant, size_t const &limit = std::numeric_limits<size_t>::max());
+
+    Matrix Map(Matrix const &matrix, Pass const &pass);
+    std::vector<Scalar> Arguments(Scalar const &scalar, Pass const &pass);
+    void Parallel(size_t const &count, std::function<void(ExpressionSimplifier &, size_t const &)> const &body);
+
+    Scalar Memoize(SimplificationCache::Pass const &pass, Scalar const &scalar, std::function<Scalar(Scalar)> const &rewrite);
+    size_t Hash(Scalar const &scalar);
+
+    size_t Key(Scalar const &scalar);
+    size_t Key(std::string const &key_str);
+
+    size_t Order(Scalar const &scalar);
+    bool Precedes(Scalar const &lhs, Scalar const &rhs);
 
     static std::vector<Scalar> Factors(Scalar const &node_scalar);    
     static std::vector<Scalar> Addends(Scalar const &node_scalar);
@@ -27,7 +27,7 @@ void ExpressionVisualizer::Visualize(std::ostream &ostream, std::variant<Scalar,
     ostream << std::string(depth * 4, ' ');
     
     if (std::holds_alternative<Matrix>(node_variant)) {
-        Matrix matrix = std::get<Matrix>(node_variant);
+        Matrix const &matrix = std::get<Matrix>(node_variant);
         
         ostream << "[Matrix] ";
         ostream << matrix << std::endl;
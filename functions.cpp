@@ -16,6 +16,11 @@ std::string CosNode::Type() const
     return "CosNode";
 }
 
+Scalar CosNode::Clone() const
+{
+    return Scalar(new CosNode(*this));
+}
+
 std::complex<double> CosNode::Value() const
 {
     return std::cos(Argument(0)->Value());
@@ -33,6 +38,11 @@ std::string SinNode::Type() const
     return "SinNode";
 }
 
+Scalar SinNode::Clone() const
+{
+    return Scalar(new SinNode(*this));
+}
+
 std::complex<double> SinNode::Value() const
 {
     return std::sin(Argument(0)->Value());
@@ -50,6 +60,11 @@ std::string TanNode::Type() const
     return "TanNode";
 }
 
+Scalar TanNode::Clone() const
+{
+    return Scalar(new TanNode(*this));
+}
+
 std::complex<double> TanNode::Value() const
 {
     return std::tan(Argument(0)->Value());
@@ -67,6 +82,11 @@ std::string AcosNode::Type() const
     return "AcosNode";
 }
 
+Scalar AcosNode::Clone() const
+{
+    return Scalar(new AcosNode(*this));
+}
+
 std::complex<double> AcosNode::Value() const
 {
     return std::acos(Argument(0)->Value());
@@ -84,6 +104,11 @@ std::string AsinNode::Type() const
     return "AsinNode";
 }
 
+Scalar AsinNode::Clone() const
+{
+    return Scalar(new AsinNode(*this));
+}
+
 std::complex<double> AsinNode::Value() const
 {
     return std::asin(Argument(0)->Value());
@@ -101,6 +126,11 @@ std::string AtanNode::Type() const
     return "AtanNode";
 }
 
+Scalar AtanNode::Clone() const
+{
+    return Scalar(new AtanNode(*this));
+}
+
 std::complex<double> AtanNode::Value() const
 {
     return std::atan(Argument(0)->Value());
@@ -118,6 +148,11 @@ std::string SqrtNode::Type() const
     return "SqrtNode";
 }
 
+Scalar SqrtNode::Clone() const
+{
+    return Scalar(new SqrtNode(*this));
+}
+
 std::complex<double> SqrtNode::Value() const
 {
     return std::sqrt(Argument(0)->Value());
@@ -135,6 +170,11 @@ std::string AbsNode::Type() const
     return "AbsNode";
 }
 
+Scalar AbsNode::Clone() const
+{
+    return Scalar(new AbsNode(*this));
+}
+
 std::complex<double> AbsNode::Value() const
 {
     return std::abs(Argument(0)->Value());
@@ -152,6 +192,11 @@ std::string ExpNode::Type() const
     return "ExpNode";
 }
 
+Scalar ExpNode::Clone() const
+{
+    return Scalar(new ExpNode(*this));
+}
+
 std::complex<double> ExpNode::Value() const
 {
     return std::exp(Argument(0)->Value());
@@ -169,6 +214,11 @@ std::string LnNode::Type() const
     return "LnNode";
 }
 
+Scalar LnNode::Clone() const
+{
+    return Scalar(new LnNode(*this));
+}
+
 std::complex<double> LnNode::Value() const
 {
     return std::log(Argument(0)->Value());
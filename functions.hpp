@@ -16,6 +16,7 @@ public:
     CosNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -26,6 +27,7 @@ public:
     SinNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -36,6 +38,7 @@ public:
     TanNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -46,6 +49,7 @@ public:
     AcosNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -56,6 +60,7 @@ public:
     AsinNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -66,6 +71,7 @@ public:
     AtanNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -76,6 +82,7 @@ public:
     SqrtNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -86,6 +93,7 @@ public:
     AbsNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -96,6 +104,7 @@ public:
     ExpNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -106,6 +115,7 @@ public:
     LnNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "lu_decomposition.hpp"
+
+LUDecomposition::LUDecomposition(Matrix const &matrix) : m_dim(matrix.Rows()), m_lu(matrix.Rows() * matrix.Cols()), m_pivots(matrix.Rows()), m_sign(1.0), m_singular(false)
+{
+    if (matrix.Rows() != matrix.Cols()) {
+        throw std::invalid_argument("Matrix is not square");
+    }
+
+    for (size_t i = 0; i < m_dim; ++i) {
+        for (size_t j = 0; j < m_dim; ++j) {
+            m_lu[i * m_dim + j] = matrix.Value(i, j);
+        }
+    }
+
+    std::iota(std::begin(m_pivots), std::end(m_pivots), 0);
+
+    // Doolittle decomposition PA = LU with partial pivoting, L and U are stored in-place with an implied unit diagonal for L
+    for (size_t k = 0; k < m_dim; ++k) {
+        size_t pivot = k;
+
+        for (size_t i = k + 1; i < m_dim; ++i) {
+            if (std::abs(m_lu[i * m_dim + k]) > std::abs(m_lu[pivot * m_dim + k])) {
+                pivot = i;
+            }
+        }
+
+        if (std::abs(m_lu[pivot * m_dim + k]) == 0.0) {
+            m_singular = true;
+
+            continue;
+        }
+
+        if (pivot != k) {
+            std::swap_ranges(std::begin(m_lu) + k * m_dim, std::begin(m_lu) + (k + 1) * m_dim, std::begin(m_lu) + pivot * m_dim);
+            std::swap(m_pivots[k], m_pivots[pivot]);
+
+            m_sign = -m_sign;
+        }
+
+        std::complex<double> const diagonal = m_lu[k * m_dim + k];
+
+        for (size_t i = k + 1; i < m_dim; ++i) {
+            std::complex<double> const factor = (m_lu[i * m_dim + k] /= diagonal);
+
+            for (size_t j = k + 1; j < m_dim; ++j) {
+                m_lu[i * m_dim + j] -= factor * m_lu[k * m_dim + j];
+            }
+        }
+    }
+}
+
+size_t LUDecomposition::Dim() const
+{
+    return m_dim;
+}
+
+bool LUDecomposition::Singular() const
+{
+    return m_singular;
+}
+
+std::complex<double> LUDecomposition::Determinant() const
+{
+    if (m_singular) {
+        return 0.0;
+    }
+
+    std::complex<double> determinant = m_sign;
+
+    for (size_t k = 0; k < m_dim; ++k) {
+        determinant *= m_lu[k * m_dim + k];
+    }
+
+    return determinant;
+}
+
+Matrix LUDecomposition::Inverse() const
+{
+    if (m_singular || std::abs(Determinant()) < 1e-9) {
+        throw std::invalid_argument("Matrix is singular");
+    }
+
+    NumericMatrix inverse(m_dim, m_dim);
+
+    std::vector<std::complex<double>> column(m_dim);
+
+    // Solve LU x = P e_j for every column of the identity
+    for (size_t j = 0; j < m_dim; ++j) {
+        for (size_t i = 0; i < m_dim; ++i) {
+            column[i] = m_pivots[i] == j ? 1.0 : 0.0;
+        }
+
+        Substitute(column);
+
+        for (size_t i = 0; i < m_dim; ++i) {
+            inverse.Set(i, j, column[i]);
+        }
+    }
+
+    return Matrix(inverse);
+}
+
+Matrix LUDecomposition::Solve(Matrix const &rhs) const
+{
+    if (rhs.Rows() != m_dim) {
+        throw std::invalid_argument("LUDecomposition: RHS rows must equal matrix dimension");
+    }
+
+    if (m_singular || std::abs(Determinant()) < 1e-9) {
+        throw std::invalid_argument("Matrix is singular");
+    }
+
+    NumericMatrix solution(m_dim, rhs.Cols());
+
+    std::vector<std::complex<double>> column(m_dim);
+
+    for (size_t j = 0; j < rhs.Cols(); ++j) {
+        for (size_t i = 0; i < m_dim; ++i) {
+            column[i] = rhs.Value(m_pivots[i], j);
+        }
+
+        Substitute(column);
+
+        for (size_t i = 0; i < m_dim; ++i) {
+            solution.Set(i, j, column[i]);
+        }
+    }
+
+    return Matrix(solution);
+}
+
+// Forward substitution with the unit lower triangle followed by back substitution with the upper triangle
+void LUDecomposition::Substitute(std::vector<std::complex<double>> &column) const
+{
+    for (size_t i = 0; i < m_dim; ++i) {
+        for (size_t k = 0; k < i; ++k) {
+            column[i] -= m_lu[i * m_dim + k] * column[k];
+        }
+    }
+
+    for (size_t i = m_dim; i-- > 0;) {
+        for (size_t k = i + 1; k < m_dim; ++k) {
+            column[i] -= m_lu[i * m_dim + k] * column[k];
+        }
+
+        column[i] /= m_lu[i * m_dim + i];
+    }
+}
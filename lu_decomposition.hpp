@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <stdexcept>
+
+#include "node.hpp"
+#include "matrix.hpp"
+
+class LUDecomposition
+{
+    size_t m_dim;
+
+    std::vector<std::complex<double>> m_lu;
+    std::vector<size_t> m_pivots;
+
+    double m_sign;
+    bool m_singular;
+
+public:
+    LUDecomposition(Matrix const &matrix);
+
+    size_t Dim() const;
+    bool Singular() const;
+
+    std::complex<double> Determinant() const;
+    Matrix Inverse() const;
+    Matrix Solve(Matrix const &rhs) const;
+
+private:
+    void Substitute(std::vector<std::complex<double>> &column) const;
+};
@@ -5,35 +5,59 @@
 #include "matrix.hpp"
 #include "node.hpp"
 #include "operations.hpp"
+#include "lu_decomposition.hpp"
+#include "matrix_expression.hpp"
+#include "thread_pool.hpp"
 
 Matrix Matrix::Identity(size_t const &dim)
 {
-    Matrix identity(dim, dim);
+    return Matrix(SparseMatrix::Identity(dim));
+}
 
-    for (size_t i = 0; i < dim; ++i) {
-        for (size_t j = 0; j < dim; ++j) {
-            if (i == j) {
-                identity(i, j) = Scalar(new ConstantNode(1.0));
-            }
-            else {
-                identity(i, j) = Scalar(new ConstantNode(0.0));
-            }
-        }
+Matrix::Matrix()
+{
+}
+
+Matrix::Matrix(size_t const &rows, size_t const &cols) : m_rows(rows), m_cols(cols), m_elements(std::make_shared<std::vector<Scalar>>(rows * cols))
+{
+}
+
+Matrix::Matrix(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements) : m_rows(rows), m_cols(cols), m_elements(std::make_shared<std::vector<Scalar>>(elements))
+{
+    // Only a shallow check, deeper constant trees get their slot on the first factorization
+    if (std::all_of(std::cbegin(elements), std::cend(elements), [](Scalar const &element) -> bool { return element->Type() == "ConstantNode"; })) {
+        m_factorization = std::make_shared<Factorization>();
     }
+}
 
-    return identity;
+Matrix::Matrix(NumericMatrix const &numeric) : m_rows(numeric.Rows()), m_cols(numeric.Cols()), m_numeric(new NumericMatrix(numeric)), m_factorization(std::make_shared<Factorization>())
+{
 }
 
-Matrix::Matrix()
+Matrix::Matrix(SparseMatrix const &sparse) : m_rows(sparse.Rows()), m_cols(sparse.Cols()), m_sparse(new SparseMatrix(sparse))
+{
+}
+
+Matrix::Matrix(MatrixExpression const &expression) : m_rows(expression.Rows()), m_cols(expression.Cols()), m_expression(new MatrixExpression(expression))
 {
 }
 
-Matrix::Matrix(size_t const &rows, size_t const &cols) : m_rows(rows), m_cols(cols), m_elements(rows * cols)
+Matrix::Matrix(Matrix const &other) : m_rows(other.m_rows), m_cols(other.m_cols), m_elements(other.m_elements), m_view(other.m_view), m_numeric(other.m_numeric), m_sparse(other.m_sparse), m_expression(other.m_expression), m_factorization(std::atomic_load(&other.m_factorization))
 {
 }
 
-Matrix::Matrix(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements) : m_rows(rows), m_cols(cols), m_elements(elements)
+Matrix &Matrix::operator=(Matrix const &other)
 {
+    m_rows = other.m_rows;
+    m_cols = other.m_cols;
+    m_elements = other.m_elements;
+    m_view = other.m_view;
+    m_numeric = other.m_numeric;
+    m_sparse = other.m_sparse;
+    m_expression = other.m_expression;
+    m_factorization = std::atomic_load(&other.m_factorization);
+
+    return *this;
 }
 
 size_t Matrix::Rows() const
@@ -48,38 +72,499 @@ size_t Matrix::Cols() const
 
 Scalar &Matrix::operator()(size_t const &row, size_t const &col)
 {
-    return m_elements[row * m_cols + col];
+    Materialize();
+
+    return (*m_elements)[row * m_cols + col];
 }
 
 Scalar Matrix::operator()(size_t const &row, size_t const &col) const
 {
-    return m_elements[row * m_cols + col];
+    if (m_numeric) {
+        return Scalar(new ConstantNode((*m_numeric)(row, col)));
+    }
+    else if (m_sparse) {
+        return (*m_sparse)(row, col);
+    }
+    else if (m_expression) {
+        return (*m_expression)(row, col);
+    }
+    else if (m_view) {
+        return (*m_view)(row, col);
+    }
+
+    return (*m_elements)[row * m_cols + col];
+}
+
+bool Matrix::Numeric() const
+{
+    if (m_numeric) {
+        return true;
+    }
+    else if (m_sparse) {
+        return m_sparse->Numeric();
+    }
+    else if (m_expression) {
+        return m_expression->Numeric();
+    }
+    else if (m_view) {
+        for (size_t i = 0; i < m_rows; ++i) {
+            for (size_t j = 0; j < m_cols; ++j) {
+                if (!Node::Constant((*m_view)(i, j))) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    return std::all_of(std::cbegin(*m_elements), std::cend(*m_elements), [](Scalar const &element) -> bool { return Node::Constant(element); });
+}
+
+bool Matrix::Sparse() const
+{
+    return static_cast<bool>(m_sparse);
+}
+
+std::shared_ptr<MatrixExpression const> Matrix::Expression() const
+{
+    return m_expression;
+}
+
+std::complex<double> Matrix::Value(size_t const &row, size_t const &col) const
+{
+    if (m_numeric) {
+        return (*m_numeric)(row, col);
+    }
+    else if (m_sparse) {
+        return m_sparse->Value(row, col);
+    }
+    else if (m_expression) {
+        return m_expression->Value(row, col);
+    }
+    else if (m_view) {
+        return (*m_view)(row, col)->Value();
+    }
+
+    return (*m_elements)[row * m_cols + col]->Value();
+}
+
+NumericMatrix Matrix::Evaluate() const
+{
+    if (m_numeric) {
+        return *m_numeric;
+    }
+    else if (m_expression) {
+        return m_expression->Evaluate();
+    }
+
+    if (m_sparse) {
+        NumericMatrix numeric(m_rows, m_cols);
+
+        for (size_t i = 0; i < m_rows; ++i) {
+            for (size_t index = m_sparse->RowOffsets()[i]; index < m_sparse->RowOffsets()[i + 1]; ++index) {
+                numeric.Set(i, m_sparse->ColIndices()[index], m_sparse->Values()[index]->Value());
+            }
+        }
+
+        return numeric;
+    }
+
+    std::vector<double> real(m_rows * m_cols);
+    std::vector<double> imag(m_rows * m_cols);
+
+    // Element trees are independent, so they are evaluated across the pool straight into planar storage
+    std::function<void(size_t const &, size_t const &)> evaluate = [this, &real, &imag](size_t const &begin, size_t const &end) {
+        for (size_t index = begin; index < end; ++index) {
+            std::complex<double> const value = (*this)(index / m_cols, index % m_cols)->Value();
+
+            real[index] = value.real();
+            imag[index] = value.imag();
+        }
+    };
+
+    if (m_rows * m_cols < min_parallel_elements) {
+        evaluate(0, m_rows * m_cols);
+    }
+    else {
+        ThreadPool::Default().ParallelFor(m_rows * m_cols, evaluate);
+    }
+
+    if (std::all_of(std::cbegin(imag), std::cend(imag), [](double const &value) -> bool { return value == 0.0; })) {
+        imag.clear();
+    }
+
+    return NumericMatrix(m_rows, m_cols, real, imag);
+}
+
+void Matrix::Materialize()
+{
+    // Writes detach the factorization, copies taken before keep theirs
+    m_factorization.reset();
+
+    if (m_numeric) {
+        std::vector<Scalar> elements(m_rows * m_cols);
+
+        for (size_t i = 0; i < m_rows; ++i) {
+            for (size_t j = 0; j < m_cols; ++j) {
+                elements[i * m_cols + j] = Scalar(new ConstantNode((*m_numeric)(i, j)));
+            }
+        }
+
+        m_elements = std::make_shared<std::vector<Scalar>>(std::move(elements));
+        m_numeric.reset();
+    }
+    else if (m_sparse) {
+        Scalar const zero(new ConstantNode(0.0));
+
+        std::vector<Scalar> elements(m_rows * m_cols, zero);
+
+        for (size_t i = 0; i < m_rows; ++i) {
+            for (size_t index = m_sparse->RowOffsets()[i]; index < m_sparse->RowOffsets()[i + 1]; ++index) {
+                elements[i * m_cols + m_sparse->ColIndices()[index]] = m_sparse->Values()[index];
+            }
+        }
+
+        m_elements = std::make_shared<std::vector<Scalar>>(std::move(elements));
+        m_sparse.reset();
+    }
+    else if (m_expression) {
+        m_elements = std::make_shared<std::vector<Scalar>>(m_expression->Materialize());
+        m_expression.reset();
+    }
+    else if (m_view) {
+        m_elements = std::make_shared<std::vector<Scalar>>(m_view->Materialize());
+        m_view.reset();
+    }
+    else if (m_elements.use_count() > 1) {
+        m_elements = std::make_shared<std::vector<Scalar>>(*m_elements);
+    }
+}
+
+Matrix Matrix::Materialized() const
+{
+    Matrix matrix(*this);
+
+    matrix.Materialize();
+
+    return matrix;
+}
+
+Matrix Matrix::Slice(std::vector<size_t> const &rows, std::vector<size_t> const &cols) const
+{
+    if (m_numeric) {
+        NumericMatrix numeric(rows.size(), cols.size());
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            for (size_t j = 0; j < cols.size(); ++j) {
+                numeric.Set(i, j, (*m_numeric)(rows[i], cols[j]));
+            }
+        }
+
+        return Matrix(numeric);
+    }
+    else if (m_sparse || m_expression) {
+        Matrix matrix(rows.size(), cols.size());
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            for (size_t j = 0; j < cols.size(); ++j) {
+                matrix(i, j) = (*this)(rows[i], cols[j]);
+            }
+        }
+
+        return matrix;
+    }
+
+    Matrix matrix;
+
+    matrix.m_rows = rows.size();
+    matrix.m_cols = cols.size();
+    matrix.m_view = std::make_shared<MatrixView const>(m_view ? m_view->Slice(rows, cols) : MatrixView(m_elements, m_cols, rows, cols));
+
+    return matrix;
+}
+
+Matrix Matrix::Add(Matrix const &other) const
+{
+    if (Rows() != other.Rows() || Cols() != other.Cols()) {
+        throw std::invalid_argument("Matrix: Dimensions are not equal");
+    }
+
+    if (m_sparse && other.m_sparse) {
+        return Matrix(m_sparse->Add(*other.m_sparse));
+    }
+    else if (m_numeric && other.m_numeric) {
+        return Matrix(m_numeric->Add(*other.m_numeric));
+    }
+    else if (!m_sparse && !other.m_sparse) {
+        return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Addition, *this, other));
+    }
+    else if (Numeric() && other.Numeric()) {
+        return Matrix(Evaluate().Add(other.Evaluate()));
+    }
+
+    Matrix matrix(Rows(), Cols());
+
+    for (size_t i = 0; i < Rows(); ++i) {
+        for (size_t j = 0; j < Cols(); ++j) {
+            Scalar lhs = (*this)(i, j);
+            Scalar rhs = other(i, j);
+
+            // Entries missing from sparse storage pass the other operand through untouched
+            if (m_sparse && !m_sparse->Stored(i, j)) {
+                matrix(i, j) = rhs;
+            }
+            else if (other.m_sparse && !other.m_sparse->Stored(i, j)) {
+                matrix(i, j) = lhs;
+            }
+            else {
+                matrix(i, j) = Scalar(new AdditionNode({ lhs, rhs }));
+            }
+        }
+    }
+
+    return matrix;
+}
+
+Matrix Matrix::Subtract(Matrix const &other) const
+{
+    if (Rows() != other.Rows() || Cols() != other.Cols()) {
+        throw std::invalid_argument("Matrix: Dimensions are not equal");
+    }
+
+    if (m_sparse && other.m_sparse) {
+        return Matrix(m_sparse->Subtract(*other.m_sparse));
+    }
+    else if (m_numeric && other.m_numeric) {
+        return Matrix(m_numeric->Subtract(*other.m_numeric));
+    }
+    else if (!m_sparse && !other.m_sparse) {
+        return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Subtraction, *this, other));
+    }
+    else if (Numeric() && other.Numeric()) {
+        return Matrix(Evaluate().Subtract(other.Evaluate()));
+    }
+
+    Matrix matrix(Rows(), Cols());
+
+    for (size_t i = 0; i < Rows(); ++i) {
+        for (size_t j = 0; j < Cols(); ++j) {
+            Scalar lhs = (*this)(i, j);
+            Scalar rhs = other(i, j);
+
+            if (other.m_sparse && !other.m_sparse->Stored(i, j)) {
+                matrix(i, j) = lhs;
+            }
+            else {
+                matrix(i, j) = Scalar(new SubtractionNode({ lhs, rhs }));
+            }
+        }
+    }
+
+    return matrix;
+}
+
+Matrix Matrix::Multiply(Matrix const &other) const
+{
+    if (Cols() != other.Rows()) {
+        throw std::invalid_argument("Matrix: LHS cols must equal RHS rows");
+    }
+
+    if (m_sparse && other.m_sparse) {
+        return Matrix(m_sparse->Multiply(*other.m_sparse));
+    }
+    else if ((m_expression || other.m_expression) && !(Numeric() && other.Numeric())) {
+        // Products read every element repeatedly, so symbolic chains are materialized once up front
+        return Materialized().Multiply(other.Materialized());
+    }
+    else if (m_sparse) {
+        return SparseDenseProduct(*m_sparse, other);
+    }
+    else if (other.m_sparse) {
+        return DenseSparseProduct(*this, *other.m_sparse);
+    }
+    else if (Numeric() && other.Numeric()) {
+        return Matrix(Evaluate().Multiply(other.Evaluate()));
+    }
+
+    Matrix matrix(Rows(), other.Cols());
+
+    for (size_t i = 0; i < Rows(); ++i) {
+        for (size_t j = 0; j < other.Cols(); ++j) {
+            Scalar sum(new ConstantNode(0.0));
+
+            for (size_t k = 0; k < Cols(); ++k) {
+                Scalar product(new MultiplicationNode({ (*this)(i, k), other(k, j) }));
+                
+                sum = Scalar(new AdditionNode({ sum, product }));
+            }
+
+            matrix(i, j) = sum;
+        }
+    }
+
+    return matrix;
+}
+
+Matrix Matrix::Scale(Scalar const &factor) const
+{
+    if (m_sparse) {
+        return Matrix(m_sparse->Scale(factor));
+    }
+
+    return Matrix(MatrixExpression::Binary(MatrixExpression::Operation::Multiplication, factor, *this));
 }
 
-/*
 Matrix Matrix::Pow(int32_t const &other) const
 {
     if (Rows() != Cols()) {
         throw std::invalid_argument("Matrix is not square");
     }
 
-    if (other == 0) {
-        return Matrix::Identity(Rows());
+    if (other < 0) {
+        return Inverse().PowBySquaring(static_cast<uint64_t>(-static_cast<int64_t>(other)));
     }
-    else if (other > 0) {
-        Matrix pow = (*this);
 
-        for (size_t i = 1; i < other; ++i) {
-            pow = pow * (*this);
+    return PowBySquaring(static_cast<uint64_t>(other));
+}
+
+// Exponentiation by squaring, O(log k) products
+Matrix Matrix::PowBySquaring(uint64_t const &exponent) const
+{
+    Matrix pow = Matrix::Identity(Rows());
+    Matrix base = (*this);
+
+    bool identity = true;
+
+    for (uint64_t remaining = exponent; remaining > 0; remaining >>= 1) {
+        if (remaining & 1) {
+            pow = identity ? base : pow.Multiply(base);
+
+            identity = false;
         }
 
-        return pow;
+        if (remaining > 1) {
+            base = base.Multiply(base);
+        }
     }
-    else {
-        return Inverse() ^ (other * -1);
+
+    return pow;
+}
+
+// Sparse-dense products only visit stored entries, so a dense column vector costs O(nnz)
+Matrix Matrix::SparseDenseProduct(SparseMatrix const &lhs, Matrix const &rhs)
+{
+    std::vector<size_t> const &row_offsets = lhs.RowOffsets();
+    std::vector<size_t> const &col_indices = lhs.ColIndices();
+    std::vector<Scalar> const &values = lhs.Values();
+
+    if (lhs.Numeric() && rhs.Numeric()) {
+        NumericMatrix rhs_numeric = rhs.Evaluate();
+        NumericMatrix numeric(lhs.Rows(), rhs.Cols());
+
+        std::vector<std::complex<double>> row(rhs.Cols());
+
+        for (size_t i = 0; i < lhs.Rows(); ++i) {
+            std::fill(std::begin(row), std::end(row), 0.0);
+
+            for (size_t index = row_offsets[i]; index < row_offsets[i + 1]; ++index) {
+                std::complex<double> const value = values[index]->Value();
+
+                for (size_t j = 0; j < rhs.Cols(); ++j) {
+                    row[j] += value * rhs_numeric(col_indices[index], j);
+                }
+            }
+
+            for (size_t j = 0; j < rhs.Cols(); ++j) {
+                numeric.Set(i, j, row[j]);
+            }
+        }
+
+        return Matrix(numeric);
+    }
+
+    Matrix matrix(lhs.Rows(), rhs.Cols());
+
+    for (size_t i = 0; i < lhs.Rows(); ++i) {
+        for (size_t j = 0; j < rhs.Cols(); ++j) {
+            Scalar sum;
+
+            for (size_t index = row_offsets[i]; index < row_offsets[i + 1]; ++index) {
+                Scalar product = SparseMatrix::Product(values[index], rhs(col_indices[index], j));
+
+                sum = sum ? SparseMatrix::Sum(sum, product) : product;
+            }
+
+            matrix(i, j) = sum ? sum : Scalar(new ConstantNode(0.0));
+        }
     }
+
+    return matrix;
+}
+
+Matrix Matrix::DenseSparseProduct(Matrix const &lhs, SparseMatrix const &rhs)
+{
+    std::vector<size_t> const &row_offsets = rhs.RowOffsets();
+    std::vector<size_t> const &col_indices = rhs.ColIndices();
+    std::vector<Scalar> const &values = rhs.Values();
+
+    if (lhs.Numeric() && rhs.Numeric()) {
+        NumericMatrix lhs_numeric = lhs.Evaluate();
+        NumericMatrix numeric(lhs.Rows(), rhs.Cols());
+
+        std::vector<std::complex<double>> row(rhs.Cols());
+
+        for (size_t i = 0; i < lhs.Rows(); ++i) {
+            std::fill(std::begin(row), std::end(row), 0.0);
+
+            for (size_t k = 0; k < lhs.Cols(); ++k) {
+                std::complex<double> const value = lhs_numeric(i, k);
+
+                if (value == 0.0) {
+                    continue;
+                }
+
+                for (size_t index = row_offsets[k]; index < row_offsets[k + 1]; ++index) {
+                    row[col_indices[index]] += value * values[index]->Value();
+                }
+            }
+
+            for (size_t j = 0; j < rhs.Cols(); ++j) {
+                numeric.Set(i, j, row[j]);
+            }
+        }
+
+        return Matrix(numeric);
+    }
+
+    Matrix matrix(lhs.Rows(), rhs.Cols());
+
+    std::vector<Scalar> row(rhs.Cols());
+
+    for (size_t i = 0; i < lhs.Rows(); ++i) {
+        for (size_t k = 0; k < lhs.Cols(); ++k) {
+            Scalar element = lhs(i, k);
+
+            if (SparseMatrix::Absent(element)) {
+                continue;
+            }
+
+            for (size_t index = row_offsets[k]; index < row_offsets[k + 1]; ++index) {
+                Scalar product = SparseMatrix::Product(element, values[index]);
+
+                row[col_indices[index]] = row[col_indices[index]] ? SparseMatrix::Sum(row[col_indices[index]], product) : product;
+            }
+        }
+
+        for (size_t j = 0; j < rhs.Cols(); ++j) {
+            matrix(i, j) = row[j] ? row[j] : Scalar(new ConstantNode(0.0));
+
+            row[j] = nullptr;
+        }
+    }
+
+    return matrix;
 }
-*/
 
 Matrix Matrix::Submatrix(size_t const &row, size_t const &col) const
 {
@@ -87,40 +572,93 @@ Matrix Matrix::Submatrix(size_t const &row, size_t const &col) const
         throw std::out_of_range("Invalid submatrix indices");
     }
 
-    Matrix matrix(Rows() - 1, Cols() - 1);
+    if (m_sparse) {
+        return Matrix(m_sparse->Submatrix(row, col));
+    }
+
+    std::vector<size_t> rows(Rows() - 1);
+    std::vector<size_t> cols(Cols() - 1);
 
-    for (size_t i = 0; i < Rows() - 1; ++i) {
-        for (size_t j = 0; j < Cols() - 1; ++j) {
-            matrix(i, j) = (*this)(i + (i >= row ? 1 : 0), j + (j >= col ? 1 : 0));
-        }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        rows[i] = i + (i >= row ? 1 : 0);
     }
 
-    return matrix;
+    for (size_t j = 0; j < cols.size(); ++j) {
+        cols[j] = j + (j >= col ? 1 : 0);
+    }
+
+    return Slice(rows, cols);
+}
+
+Matrix Matrix::Row(size_t const &row) const
+{
+    if (Rows() <= row) {
+        throw std::out_of_range("Invalid row index");
+    }
+
+    std::vector<size_t> cols(Cols());
+
+    std::iota(std::begin(cols), std::end(cols), 0);
+
+    return Slice({ row }, cols);
+}
+
+Matrix Matrix::Col(size_t const &col) const
+{
+    if (Cols() <= col) {
+        throw std::out_of_range("Invalid col index");
+    }
+
+    std::vector<size_t> rows(Rows());
+
+    std::iota(std::begin(rows), std::end(rows), 0);
+
+    return Slice(rows, { col });
 }
 
 Matrix Matrix::Transpose() const
 {
-    Matrix matrix(Cols(), Rows());
+    if (m_sparse) {
+        return Matrix(m_sparse->Transpose());
+    }
+    else if (m_expression) {
+        return Materialized().Transpose();
+    }
+    else if (m_numeric) {
+        return Matrix(m_numeric->Transpose());
+    }
 
-    for (size_t i = 0; i < Rows(); ++i) {
-        for (size_t j = 0; j < Cols(); ++j) {
-            matrix(j, i) = (*this)(i, j);
-        }
+    Matrix matrix;
+
+    matrix.m_rows = Cols();
+    matrix.m_cols = Rows();
+
+    if (m_view) {
+        matrix.m_view = std::make_shared<MatrixView const>(m_view->Transpose());
+    }
+    else {
+        std::vector<size_t> rows(Rows());
+        std::vector<size_t> cols(Cols());
+
+        std::iota(std::begin(rows), std::end(rows), 0);
+        std::iota(std::begin(cols), std::end(cols), 0);
+
+        matrix.m_view = std::make_shared<MatrixView const>(MatrixView(m_elements, m_cols, rows, cols).Transpose());
     }
 
     return matrix;
 }
 
-Scalar Matrix::Minor(size_t const &row, size_t const &col) const
+Scalar Matrix::Minor(size_t const &row, size_t const &col, Method const &method) const
 {
     if (Rows() != Cols()) {
         throw std::invalid_argument("Matrix is not square");
     }
 
-    return Submatrix(row, col).Determinant();
+    return Submatrix(row, col).Determinant(method);
 }
 
-Scalar Matrix::Determinant() const
+Scalar Matrix::Determinant(Method const &method) const
 {
     if (Rows() != Cols()) {
         throw std::invalid_argument("Matrix is not square");
@@ -130,10 +668,23 @@ Scalar Matrix::Determinant() const
         return (*this)(0, 0);
     }
 
+    Method resolved = Resolve(method);
+
+    // Numeric entries never change value, so collapse them to a single constant in O(n^3)
+    if (resolved == Method::LU) {
+        return Scalar(new ConstantNode(DeterminantValue()));
+    }
+    else if (resolved == Method::Berkowitz) {
+        // det(A) = (-1)^n * c_n
+        Scalar constant = Characteristic().back();
+
+        return Rows() % 2 == 0 ? constant : Negate(constant);
+    }
+
     Scalar determinant(new ConstantNode(0.0));
 
     for (size_t j = 0; j < Cols(); ++j) {
-        Scalar product = Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ (*this)(0, j), Minor(0, j) })), Scalar(new ConstantNode(j % 2 == 0 ? 1.0 : -1.0)) }));
+        Scalar product = Scalar(new MultiplicationNode({ Scalar(new MultiplicationNode({ (*this)(0, j), Minor(0, j, resolved) })), Scalar(new ConstantNode(j % 2 == 0 ? 1.0 : -1.0)) }));
 
         determinant = Scalar(new AdditionNode({ determinant, product }));
     }
@@ -141,28 +692,76 @@ Scalar Matrix::Determinant() const
     return determinant;
 }
 
-Matrix Matrix::Cofactor() const
+Matrix Matrix::Cofactor(Method const &method) const
 {
+    Method resolved = Resolve(method);
+
+    // C = adj(A)^T, which LU and Berkowitz yield for every entry at once
+    if (Rows() == Cols() && Rows() > 1 && resolved == Method::Berkowitz) {
+        Matrix const adjugate = AdjugateProduct(Matrix::Identity(Rows()), Characteristic());
+
+        return adjugate.Transpose();
+    }
+    // A singular numeric matrix has no inverse to scale, so it falls back to per-entry minors
+    else if (Rows() == Cols() && Rows() > 1 && resolved == Method::LU) {
+        try {
+            LUDecomposition decomposition(*this);
+
+            return Matrix(decomposition.Inverse().Evaluate().Transpose().Scale(decomposition.Determinant()));
+        }
+        catch (std::invalid_argument const &) {
+        }
+    }
+
     Matrix matrix(Rows(), Cols());
 
     for (size_t i = 0; i < Rows(); ++i) {
         for (size_t j = 0; j < Cols(); ++j) {
-            matrix(i, j) = Scalar(new MultiplicationNode({ Minor(i, j), Scalar(new ConstantNode((i + j) % 2 == 0 ? 1.0 : -1.0)) })); 
+            matrix(i, j) = Scalar(new MultiplicationNode({ Minor(i, j, resolved), Scalar(new ConstantNode((i + j) % 2 == 0 ? 1.0 : -1.0)) })); 
         }
     }
 
     return matrix;
 }
 
-Matrix Matrix::Inverse() const
+Matrix Matrix::Inverse(Method const &method) const
 {
     if (Rows() != Cols()) {
         throw std::invalid_argument("Matrix must be square");
     }
 
-    Scalar determinant = Determinant();
+    Method resolved = Resolve(method);
 
-    if (std::fabs(determinant->Value()) < 1e-9) {
+    if (resolved == Method::LU) {
+        return InverseValue();
+    }
+    else if (resolved == Method::Berkowitz) {
+        if (std::abs(DeterminantValue()) < 1e-9) {
+            throw std::invalid_argument("Matrix is singular");
+        }
+
+        // The determinant is the constant coefficient, so both come out of one expansion and share its subexpressions
+        std::vector<Scalar> const coefficients = Characteristic();
+
+        Matrix const adjugate = AdjugateProduct(Matrix::Identity(Rows()), coefficients);
+
+        Scalar determinant = Rows() % 2 == 0 ? coefficients.back() : Negate(coefficients.back());
+        Scalar determinant_inverse(new DivisionNode({ Scalar(new ConstantNode(1.0)), determinant }));
+
+        Matrix inverse(Rows(), Cols());
+
+        for (size_t i = 0; i < Rows(); ++i) {
+            for (size_t j = 0; j < Cols(); ++j) {
+                inverse(i, j) = Scalar(new MultiplicationNode({ adjugate(i, j), determinant_inverse }));
+            }
+        }
+
+        return inverse;
+    }
+
+    Scalar determinant = Determinant(resolved);
+
+    if (std::abs(determinant->Value()) < 1e-9) {
         throw std::invalid_argument("Matrix is singular");
     }
 
@@ -176,7 +775,7 @@ Matrix Matrix::Inverse() const
         return inverse;
     }
 
-    Matrix cofactor = Cofactor();
+    Matrix cofactor = Cofactor(resolved);
 
     Matrix cofactor_transpose = cofactor.Transpose();
     
@@ -212,13 +811,259 @@ Matrix Matrix::Inverse() const
     return inverse;
 }
 
+Matrix Matrix::Solve(Matrix const &rhs, Method const &method) const
+{
+    if (Rows() != Cols()) {
+        throw std::invalid_argument("Matrix is not square");
+    }
+
+    if (Rows() != rhs.Rows()) {
+        throw std::invalid_argument("Matrix: LHS rows must equal RHS rows");
+    }
+
+    Method resolved = Resolve(method);
+
+    if (resolved == Method::LU) {
+        std::shared_ptr<LUDecomposition const> decomposition = Decomposition();
+
+        // A symbolic right-hand side keeps its variables through the numeric inverse
+        return rhs.Numeric() ? decomposition->Solve(rhs) : decomposition->Inverse().Multiply(rhs);
+    }
+    else if (resolved == Method::Cofactor) {
+        return Inverse(resolved).Multiply(rhs);
+    }
+
+    if (std::abs(DeterminantValue()) < 1e-9) {
+        throw std::invalid_argument("Matrix is singular");
+    }
+
+    // x = adj(A) * b / det(A), where adj(A) * b is built directly instead of through adj(A)
+    std::vector<Scalar> const coefficients = Characteristic();
+
+    Matrix const adjugate_product = AdjugateProduct(rhs, coefficients);
+
+    Scalar determinant = Rows() % 2 == 0 ? coefficients.back() : Negate(coefficients.back());
+
+    Matrix solution(rhs.Rows(), rhs.Cols());
+
+    for (size_t i = 0; i < solution.Rows(); ++i) {
+        for (size_t j = 0; j < solution.Cols(); ++j) {
+            Scalar const element = adjugate_product(i, j);
+
+            solution(i, j) = SparseMatrix::Absent(element) ? element : Scalar(new DivisionNode({ element, determinant }));
+        }
+    }
+
+    return solution;
+}
+
+std::shared_ptr<LUDecomposition const> Matrix::Decomposition() const
+{
+    // Symbolic matrices change value with their variables, so only numeric factorizations are kept
+    if (!Numeric()) {
+        return std::make_shared<LUDecomposition const>(*this);
+    }
+
+    std::shared_ptr<Factorization> factorization = std::atomic_load(&m_factorization);
+
+    // Concurrent first calls agree on one slot, the loser of the exchange picks up the winner's
+    if (!factorization) {
+        std::shared_ptr<Factorization> const created = std::make_shared<Factorization>();
+
+        if (std::atomic_compare_exchange_strong(&m_factorization, &factorization, created)) {
+            factorization = created;
+        }
+    }
+
+    std::call_once(factorization->once, [this, &factorization]() {
+        factorization->decomposition = std::make_shared<LUDecomposition const>(*this);
+    });
+
+    return factorization->decomposition;
+}
+
+std::complex<double> Matrix::DeterminantValue() const
+{
+    return Decomposition()->Determinant();
+}
+
+Matrix Matrix::InverseValue() const
+{
+    return Decomposition()->Inverse();
+}
+
+Matrix::Method Matrix::Resolve(Method const &method) const
+{
+    if (method != Method::Automatic) {
+        return method;
+    }
+
+    // Neither symbolic method divides, so their results stay defined for every value of their variables
+    if (Numeric()) {
+        return Method::LU;
+    }
+    else if (Rows() <= max_cofactor_dim) {
+        return Method::Cofactor;
+    }
+    else {
+        return Method::Berkowitz;
+    }
+}
+
+// sum + lhs * rhs, exact zeros add no term so that sparse and triangular matrices keep their expressions small
+Scalar Matrix::Accumulate(Scalar const &sum, Scalar const &lhs, Scalar const &rhs)
+{
+    if (SparseMatrix::Absent(lhs) || SparseMatrix::Absent(rhs)) {
+        return sum;
+    }
+
+    Scalar product = lhs->Type() == "ConstantNode" && lhs->Value() == std::complex<double>(1.0, 0.0) ? rhs : SparseMatrix::Product(lhs, rhs);
+
+    if (SparseMatrix::Absent(sum)) {
+        return product;
+    }
+
+    return SparseMatrix::Sum(sum, product);
+}
+
+Scalar Matrix::Negate(Scalar const &scalar)
+{
+    if (SparseMatrix::Absent(scalar)) {
+        return scalar;
+    }
+    else if (scalar->Type() == "ConstantNode") {
+        return Scalar(new ConstantNode(-scalar->Value()));
+    }
+
+    return Scalar(new MultiplicationNode({ Scalar(new ConstantNode(-1.0)), scalar }));
+}
+
+// Berkowitz: the coefficients of det(tI - A), highest degree first, built from those of each trailing submatrix without dividing
+std::vector<Scalar> Matrix::Characteristic() const
+{
+    size_t const dim = Rows();
+
+    std::vector<Scalar> elements(dim * dim);
+
+    for (size_t i = 0; i < dim; ++i) {
+        for (size_t j = 0; j < dim; ++j) {
+            elements[i * dim + j] = (*this)(i, j);
+        }
+    }
+
+    std::vector<Scalar> coefficients = { Scalar(new ConstantNode(1.0)), Negate(elements.back()) };
+
+    // A_r = [ a R ; C M ], where M is the trailing submatrix whose coefficients are already known
+    for (size_t r = dim - 1; r-- > 0;) {
+        size_t const size = dim - r - 1;
+
+        // First column of the Toeplitz matrix: 1, -a, -R C, -R M C, ..., -R M^{size-1} C
+        std::vector<Scalar> toeplitz = { Scalar(new ConstantNode(1.0)), Negate(elements[r * dim + r]) };
+        std::vector<Scalar> column(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            column[i] = elements[(r + 1 + i) * dim + r];
+        }
+
+        for (size_t k = 0; k < size; ++k) {
+            Scalar dot(new ConstantNode(0.0));
+
+            for (size_t i = 0; i < size; ++i) {
+                dot = Accumulate(dot, elements[r * dim + r + 1 + i], column[i]);
+            }
+
+            toeplitz.push_back(Negate(dot));
+
+            if (k + 1 < size) {
+                std::vector<Scalar> product(size);
+
+                for (size_t i = 0; i < size; ++i) {
+                    product[i] = Scalar(new ConstantNode(0.0));
+
+                    for (size_t j = 0; j < size; ++j) {
+                        product[i] = Accumulate(product[i], elements[(r + 1 + i) * dim + r + 1 + j], column[j]);
+                    }
+                }
+
+                column = std::move(product);
+            }
+        }
+
+        std::vector<Scalar> extended(size + 2);
+
+        for (size_t i = 0; i < extended.size(); ++i) {
+            extended[i] = Scalar(new ConstantNode(0.0));
+
+            for (size_t j = 0; j <= std::min(i, size); ++j) {
+                extended[i] = Accumulate(extended[i], toeplitz[i - j], coefficients[j]);
+            }
+        }
+
+        coefficients = std::move(extended);
+    }
+
+    return coefficients;
+}
+
+// adj(A) * B = (-1)^{n-1} * { A^{n-1} + c_1 * A^{n-2} + ... + c_{n-1} * I } * B by Cayley-Hamilton, evaluated with Horner's rule
+Matrix Matrix::AdjugateProduct(Matrix const &rhs, std::vector<Scalar> const &coefficients) const
+{
+    size_t const dim = Rows();
+    size_t const width = rhs.Cols();
+
+    std::vector<Scalar> elements(dim * dim);
+    std::vector<Scalar> rhs_elements(dim * width);
+
+    for (size_t i = 0; i < dim; ++i) {
+        for (size_t j = 0; j < dim; ++j) {
+            elements[i * dim + j] = (*this)(i, j);
+        }
+
+        for (size_t j = 0; j < width; ++j) {
+            rhs_elements[i * width + j] = rhs(i, j);
+        }
+    }
+
+    std::vector<Scalar> horner = rhs_elements;
+
+    for (size_t k = 1; k < dim; ++k) {
+        std::vector<Scalar> product(dim * width);
+
+        for (size_t i = 0; i < dim; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                Scalar sum = Accumulate(Scalar(new ConstantNode(0.0)), coefficients[k], rhs_elements[i * width + j]);
+
+                for (size_t l = 0; l < dim; ++l) {
+                    sum = Accumulate(sum, elements[i * dim + l], horner[l * width + j]);
+                }
+
+                product[i * width + j] = sum;
+            }
+        }
+
+        horner = std::move(product);
+    }
+
+    Matrix adjugate_product(dim, width);
+
+    for (size_t i = 0; i < dim; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            adjugate_product(i, j) = dim % 2 == 0 ? Negate(horner[i * width + j]) : horner[i * width + j];
+        }
+    }
+
+    return adjugate_product;
+}
+
 std::ostream &operator<<(std::ostream &ostream, Matrix const &matrix)
 {
+    NumericMatrix numeric = matrix.Evaluate();
+
     ostream << "\\begin{bmatrix}";
 
     for (size_t i = 0; i < matrix.Rows(); ++i) {
         for (size_t j = 0; j < matrix.Cols(); ++j) {
-            ostream << matrix(i, j);
+            ostream << ConstantNode(numeric(i, j));
 
             if (j < matrix.Cols() - 1) {
                 ostream << "&";
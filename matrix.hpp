@@ -11,15 +11,60 @@
 #include <memory>
 #include <stdexcept>
 #include <variant>
+#include <mutex>
+#include <atomic>
 
 #include "node.hpp"
+#include "numeric_matrix.hpp"
+#include "sparse_matrix.hpp"
+#include "matrix_view.hpp"
+
+class LUDecomposition;
+class MatrixExpression;
 
 class Matrix
 {
+public:
+    // Cofactor expansion and Berkowitz never divide by an entry, so symbolic results stay defined for every value of their variables
+    enum class Method
+    {
+        Automatic,
+        LU,
+        Cofactor,
+        Berkowitz
+    };
+
+    static constexpr size_t max_cofactor_dim = 3;
+    static constexpr size_t min_parallel_elements = 64;
+
+private:
     size_t m_rows;
     size_t m_cols;
 
-    std::vector<Scalar> m_elements;
+    // Symbolic elements are shared between copies and only duplicated on write
+    std::shared_ptr<std::vector<Scalar>> m_elements = std::make_shared<std::vector<Scalar>>();
+
+    // Transposes and slices of symbolic matrices index into their parent's elements until written to
+    std::shared_ptr<MatrixView const> m_view;
+
+    // Numeric matrices hold their values contiguously and only allocate nodes once written to
+    std::shared_ptr<NumericMatrix const> m_numeric;
+
+    // Sparse matrices never allocate nodes for their zero entries
+    std::shared_ptr<SparseMatrix const> m_sparse;
+
+    // Elementwise chains are recorded once and only evaluated or materialized on demand
+    std::shared_ptr<MatrixExpression const> m_expression;
+
+    struct Factorization
+    {
+        std::once_flag once;
+        std::shared_ptr<LUDecomposition const> decomposition;
+    };
+
+    // Numeric matrices start with a slot so that every copy shares one factorization, others allocate it on the first one
+    // The slot is read and published atomically since const matrices are shared across threads
+    mutable std::shared_ptr<Factorization> m_factorization;
     
 public:
     static Matrix Identity(size_t const &dim);
@@ -27,23 +72,67 @@ public:
     Matrix();
     Matrix(size_t const &rows, size_t const &cols);
     Matrix(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements);
+    Matrix(NumericMatrix const &numeric);
+    Matrix(SparseMatrix const &sparse);
+    Matrix(MatrixExpression const &expression);
+
+    Matrix(Matrix const &other);
+    Matrix(Matrix &&other) = default;
+
+    Matrix &operator=(Matrix const &other);
+    Matrix &operator=(Matrix &&other) = default;
 
     size_t Rows() const;
     size_t Cols() const;
 
     Scalar &operator()(size_t const &row, size_t const &col);
     Scalar operator()(size_t const &row, size_t const &col) const;
-    
-    /*
+
+    bool Numeric() const;
+    bool Sparse() const;
+    std::shared_ptr<MatrixExpression const> Expression() const;
+    std::complex<double> Value(size_t const &row, size_t const &col) const;
+    NumericMatrix Evaluate() const;
+
+    Matrix Add(Matrix const &other) const;
+    Matrix Subtract(Matrix const &other) const;
+    Matrix Multiply(Matrix const &other) const;
+    Matrix Scale(Scalar const &factor) const;
     Matrix Pow(int32_t const &other) const;
-    */
 
     Matrix Submatrix(size_t const &row, size_t const &col) const;
+    Matrix Row(size_t const &row) const;
+    Matrix Col(size_t const &col) const;
     Matrix Transpose() const;
-    Scalar Minor(size_t const &row, size_t const &col) const;
-    Scalar Determinant() const;
-    Matrix Cofactor() const;
-    Matrix Inverse() const;
+    Scalar Minor(size_t const &row, size_t const &col, Method const &method = Method::Automatic) const;
+    Scalar Determinant(Method const &method = Method::Automatic) const;
+    Matrix Cofactor(Method const &method = Method::Automatic) const;
+    Matrix Inverse(Method const &method = Method::Automatic) const;
+    Matrix Solve(Matrix const &rhs, Method const &method = Method::Automatic) const;
+
+    std::shared_ptr<LUDecomposition const> Decomposition() const;
+    std::complex<double> DeterminantValue() const;
+    Matrix InverseValue() const;
+
+private:
+    void Materialize();
+    Matrix Materialized() const;
+
+    Matrix Slice(std::vector<size_t> const &rows, std::vector<size_t> const &cols) const;
 
+    Matrix PowBySquaring(uint64_t const &exponent) const;
+
+    static Matrix SparseDenseProduct(SparseMatrix const &lhs, Matrix const &rhs);
+    static Matrix DenseSparseProduct(Matrix const &lhs, SparseMatrix const &rhs);
+
+    Method Resolve(Method const &method) const;
+
+    static Scalar Accumulate(Scalar const &sum, Scalar const &lhs, Scalar const &rhs);
+    static Scalar Negate(Scalar const &scalar);
+
+    std::vector<Scalar> Characteristic() const;
+    Matrix AdjugateProduct(Matrix const &rhs, std::vector<Scalar> const &coefficients) const;
+
+public:
     friend std::ostream &operator<<(std::ostream &ostream, Matrix const &matrix);
 };
@@ -0,0 +1,343 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "matrix_expression.hpp"
+#include "thread_pool.hpp"
+
+MatrixExpression::MatrixExpression(size_t const &rows, size_t const &cols) : m_rows(rows), m_cols(cols)
+{
+}
+
+MatrixExpression::MatrixExpression(Matrix const &operand) : m_rows(operand.Rows()), m_cols(operand.Cols()), m_program({ { Operation::Operand, 0 } }), m_operands({ std::make_shared<Matrix const>(operand) })
+{
+}
+
+MatrixExpression MatrixExpression::Unary(Operation const &operation, Matrix const &arg)
+{
+    if (!Unary(operation)) {
+        throw std::invalid_argument("MatrixExpression: Operation is not unary");
+    }
+
+    MatrixExpression expression = Of(arg);
+
+    expression.m_program.push_back({ operation, 0 });
+
+    return expression;
+}
+
+MatrixExpression MatrixExpression::Binary(Operation const &operation, Matrix const &lhs, Matrix const &rhs)
+{
+    if (lhs.Rows() != rhs.Rows() || lhs.Cols() != rhs.Cols()) {
+        throw std::invalid_argument("MatrixExpression: Dimensions are not equal");
+    }
+
+    MatrixExpression expression = Of(lhs);
+
+    expression.Append(Of(rhs));
+    expression.m_program.push_back({ operation, 0 });
+
+    return expression;
+}
+
+MatrixExpression MatrixExpression::Binary(Operation const &operation, Scalar const &lhs, Matrix const &rhs)
+{
+    MatrixExpression expression(rhs.Rows(), rhs.Cols());
+
+    expression.m_program.push_back({ Operation::Broadcast, 0 });
+    expression.m_scalars.push_back(lhs);
+
+    expression.Append(Of(rhs));
+    expression.m_program.push_back({ operation, 0 });
+
+    return expression;
+}
+
+MatrixExpression MatrixExpression::Binary(Operation const &operation, Matrix const &lhs, Scalar const &rhs)
+{
+    MatrixExpression expression = Of(lhs);
+
+    expression.m_program.push_back({ Operation::Broadcast, expression.m_scalars.size() });
+    expression.m_scalars.push_back(rhs);
+
+    expression.m_program.push_back({ operation, 0 });
+
+    return expression;
+}
+
+size_t MatrixExpression::Rows() const
+{
+    return m_rows;
+}
+
+size_t MatrixExpression::Cols() const
+{
+    return m_cols;
+}
+
+bool MatrixExpression::Numeric() const
+{
+    return std::all_of(std::cbegin(m_operands), std::cend(m_operands), [](std::shared_ptr<Matrix const> const &operand) -> bool { return operand->Numeric(); }) &&
+        std::all_of(std::cbegin(m_scalars), std::cend(m_scalars), [](Scalar const &scalar) -> bool { return Node::Constant(scalar); });
+}
+
+Scalar MatrixExpression::operator()(size_t const &row, size_t const &col) const
+{
+    std::vector<Scalar> stack;
+
+    for (Instruction const &instruction : m_program) {
+        if (instruction.operation == Operation::Operand) {
+            stack.push_back((*m_operands[instruction.index])(row, col));
+        }
+        else if (instruction.operation == Operation::Broadcast) {
+            stack.push_back(m_scalars[instruction.index]);
+        }
+        else if (Unary(instruction.operation)) {
+            stack.back() = Apply(instruction.operation, stack.back(), nullptr);
+        }
+        else {
+            Scalar rhs = stack.back();
+
+            stack.pop_back();
+
+            stack.back() = Apply(instruction.operation, stack.back(), rhs);
+        }
+    }
+
+    return stack.back();
+}
+
+std::complex<double> MatrixExpression::Value(size_t const &row, size_t const &col) const
+{
+    std::vector<std::complex<double>> stack;
+
+    for (Instruction const &instruction : m_program) {
+        if (instruction.operation == Operation::Operand) {
+            stack.push_back(m_operands[instruction.index]->Value(row, col));
+        }
+        else if (instruction.operation == Operation::Broadcast) {
+            stack.push_back(m_scalars[instruction.index]->Value());
+        }
+        else if (Unary(instruction.operation)) {
+            stack.back() = Apply(instruction.operation, stack.back(), 0.0);
+        }
+        else {
+            std::complex<double> rhs = stack.back();
+
+            stack.pop_back();
+
+            stack.back() = Apply(instruction.operation, stack.back(), rhs);
+        }
+    }
+
+    return stack.back();
+}
+
+NumericMatrix MatrixExpression::Evaluate() const
+{
+    std::vector<NumericMatrix> operands;
+    std::vector<std::complex<double>> scalars;
+
+    std::transform(std::cbegin(m_operands), std::cend(m_operands), std::back_inserter(operands), [](std::shared_ptr<Matrix const> const &operand) -> NumericMatrix { return operand->Evaluate(); });
+    std::transform(std::cbegin(m_scalars), std::cend(m_scalars), std::back_inserter(scalars), [](Scalar const &scalar) -> std::complex<double> { return scalar->Value(); });
+
+    std::vector<double> real(m_rows * m_cols);
+    std::vector<double> imag(m_rows * m_cols);
+
+    size_t const depth = Depth();
+
+    // Every instruction sweeps a whole row, so the chain is fused into one pass without temporary matrices or nodes
+    ThreadPool::Default().ParallelFor(m_rows, [this, &operands, &scalars, &real, &imag, &depth](size_t const &begin, size_t const &end) {
+        std::vector<std::vector<std::complex<double>>> stack(depth, std::vector<std::complex<double>>(m_cols));
+
+        for (size_t i = begin; i < end; ++i) {
+            size_t top = 0;
+
+            for (Instruction const &instruction : m_program) {
+                if (instruction.operation == Operation::Operand) {
+                    for (size_t j = 0; j < m_cols; ++j) {
+                        stack[top][j] = operands[instruction.index](i, j);
+                    }
+
+                    ++top;
+                }
+                else if (instruction.operation == Operation::Broadcast) {
+                    std::fill(std::begin(stack[top]), std::end(stack[top]), scalars[instruction.index]);
+
+                    ++top;
+                }
+                else if (Unary(instruction.operation)) {
+                    std::transform(std::cbegin(stack[top - 1]), std::cend(stack[top - 1]), std::begin(stack[top - 1]), [&instruction](std::complex<double> const &arg) -> std::complex<double> { return Apply(instruction.operation, arg, 0.0); });
+                }
+                else {
+                    --top;
+
+                    std::transform(std::cbegin(stack[top - 1]), std::cend(stack[top - 1]), std::cbegin(stack[top]), std::begin(stack[top - 1]), [&instruction](std::complex<double> const &lhs, std::complex<double> const &rhs) -> std::complex<double> { return Apply(instruction.operation, lhs, rhs); });
+                }
+            }
+
+            for (size_t j = 0; j < m_cols; ++j) {
+                real[i * m_cols + j] = stack[0][j].real();
+                imag[i * m_cols + j] = stack[0][j].imag();
+            }
+        }
+    });
+
+    if (std::all_of(std::cbegin(imag), std::cend(imag), [](double const &value) -> bool { return value == 0.0; })) {
+        imag.clear();
+    }
+
+    return NumericMatrix(m_rows, m_cols, real, imag);
+}
+
+std::vector<Scalar> MatrixExpression::Materialize() const
+{
+    std::vector<Scalar> elements;
+
+    elements.reserve(m_rows * m_cols);
+
+    for (size_t i = 0; i < m_rows; ++i) {
+        for (size_t j = 0; j < m_cols; ++j) {
+            elements.push_back((*this)(i, j));
+        }
+    }
+
+    return elements;
+}
+
+MatrixExpression MatrixExpression::Of(Matrix const &matrix)
+{
+    std::shared_ptr<MatrixExpression const> expression = matrix.Expression();
+
+    return expression ? *expression : MatrixExpression(matrix);
+}
+
+void MatrixExpression::Append(MatrixExpression const &other)
+{
+    for (Instruction const &instruction : other.m_program) {
+        if (instruction.operation == Operation::Operand) {
+            m_program.push_back({ instruction.operation, instruction.index + m_operands.size() });
+        }
+        else if (instruction.operation == Operation::Broadcast) {
+            m_program.push_back({ instruction.operation, instruction.index + m_scalars.size() });
+        }
+        else {
+            m_program.push_back(instruction);
+        }
+    }
+
+    m_operands.insert(std::end(m_operands), std::cbegin(other.m_operands), std::cend(other.m_operands));
+    m_scalars.insert(std::end(m_scalars), std::cbegin(other.m_scalars), std::cend(other.m_scalars));
+}
+
+size_t MatrixExpression::Depth() const
+{
+    size_t depth = 0;
+    size_t top = 0;
+
+    for (Instruction const &instruction : m_program) {
+        if (instruction.operation == Operation::Operand || instruction.operation == Operation::Broadcast) {
+            depth = std::max(depth, ++top);
+        }
+        else if (!Unary(instruction.operation)) {
+            --top;
+        }
+    }
+
+    return depth;
+}
+
+bool MatrixExpression::Unary(Operation const &operation)
+{
+    return operation != Operation::Operand && operation != Operation::Broadcast && operation != Operation::Addition && operation != Operation::Subtraction && operation != Operation::Multiplication;
+}
+
+Scalar MatrixExpression::Apply(Operation const &operation, Scalar const &lhs, Scalar const &rhs)
+{
+    if (operation == Operation::Addition) {
+        return Scalar(new AdditionNode({ lhs, rhs }));
+    }
+    else if (operation == Operation::Subtraction) {
+        return Scalar(new SubtractionNode({ lhs, rhs }));
+    }
+    else if (operation == Operation::Multiplication) {
+        return Scalar(new MultiplicationNode({ lhs, rhs }));
+    }
+    else if (operation == Operation::Cos) {
+        return Scalar(new CosNode({ lhs }));
+    }
+    else if (operation == Operation::Sin) {
+        return Scalar(new SinNode({ lhs }));
+    }
+    else if (operation == Operation::Tan) {
+        return Scalar(new TanNode({ lhs }));
+    }
+    else if (operation == Operation::Acos) {
+        return Scalar(new AcosNode({ lhs }));
+    }
+    else if (operation == Operation::Asin) {
+        return Scalar(new AsinNode({ lhs }));
+    }
+    else if (operation == Operation::Atan) {
+        return Scalar(new AtanNode({ lhs }));
+    }
+    else if (operation == Operation::Sqrt) {
+        return Scalar(new SqrtNode({ lhs }));
+    }
+    else if (operation == Operation::Abs) {
+        return Scalar(new AbsNode({ lhs }));
+    }
+    else if (operation == Operation::Exp) {
+        return Scalar(new ExpNode({ lhs }));
+    }
+    else if (operation == Operation::Ln) {
+        return Scalar(new LnNode({ lhs }));
+    }
+
+    throw std::invalid_argument("MatrixExpression: Unrecognized operation");
+}
+
+std::complex<double> MatrixExpression::Apply(Operation const &operation, std::complex<double> const &lhs, std::complex<double> const &rhs)
+{
+    if (operation == Operation::Addition) {
+        return lhs + rhs;
+    }
+    else if (operation == Operation::Subtraction) {
+        return lhs - rhs;
+    }
+    else if (operation == Operation::Multiplication) {
+        return lhs * rhs;
+    }
+    else if (operation == Operation::Cos) {
+        return std::cos(lhs);
+    }
+    else if (operation == Operation::Sin) {
+        return std::sin(lhs);
+    }
+    else if (operation == Operation::Tan) {
+        return std::tan(lhs);
+    }
+    else if (operation == Operation::Acos) {
+        return std::acos(lhs);
+    }
+    else if (operation == Operation::Asin) {
+        return std::asin(lhs);
+    }
+    else if (operation == Operation::Atan) {
+        return std::atan(lhs);
+    }
+    else if (operation == Operation::Sqrt) {
+        return std::sqrt(lhs);
+    }
+    else if (operation == Operation::Abs) {
+        return std::abs(lhs);
+    }
+    else if (operation == Operation::Exp) {
+        return std::exp(lhs);
+    }
+    else if (operation == Operation::Ln) {
+        return std::log(lhs);
+    }
+
+    throw std::invalid_argument("MatrixExpression: Unrecognized operation");
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "node.hpp"
+#include "operations.hpp"
+#include "functions.hpp"
+#include "matrix.hpp"
+
+class MatrixExpression
+{
+public:
+    enum class Operation
+    {
+        Operand,
+        Broadcast,
+        Addition,
+        Subtraction,
+        Multiplication,
+        Cos,
+        Sin,
+        Tan,
+        Acos,
+        Asin,
+        Atan,
+        Sqrt,
+        Abs,
+        Exp,
+        Ln
+    };
+
+private:
+    struct Instruction
+    {
+        Operation operation;
+        size_t index;
+    };
+
+    size_t m_rows;
+    size_t m_cols;
+
+    // Postfix program applied to every element, operands and broadcast scalars are referenced by index
+    std::vector<Instruction> m_program;
+    std::vector<std::shared_ptr<Matrix const>> m_operands;
+    std::vector<Scalar> m_scalars;
+
+    MatrixExpression(size_t const &rows, size_t const &cols);
+
+public:
+    MatrixExpression(Matrix const &operand);
+
+    static MatrixExpression Unary(Operation const &operation, Matrix const &arg);
+    static MatrixExpression Binary(Operation const &operation, Matrix const &lhs, Matrix const &rhs);
+    static MatrixExpression Binary(Operation const &operation, Scalar const &lhs, Matrix const &rhs);
+    static MatrixExpression Binary(Operation const &operation, Matrix const &lhs, Scalar const &rhs);
+
+    size_t Rows() const;
+    size_t Cols() const;
+
+    bool Numeric() const;
+
+    Scalar operator()(size_t const &row, size_t const &col) const;
+    std::complex<double> Value(size_t const &row, size_t const &col) const;
+
+    NumericMatrix Evaluate() const;
+    std::vector<Scalar> Materialize() const;
+
+private:
+    static MatrixExpression Of(Matrix const &matrix);
+
+    void Append(MatrixExpression const &other);
+    size_t Depth() const;
+
+    static bool Unary(Operation const &operation);
+
+    static Scalar Apply(Operation const &operation, Scalar const &lhs, Scalar const &rhs);
+    static std::complex<double> Apply(Operation const &operation, std::complex<double> const &lhs, std::complex<double> const &rhs);
+};
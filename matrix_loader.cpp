@@ -0,0 +1,197 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "matrix_loader.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MatrixLoader::MappedFile::MappedFile(std::string const &path) : m_data(nullptr), m_size(0)
+{
+    int descriptor = open(path.c_str(), O_RDONLY);
+
+    if (descriptor < 0) {
+        throw std::invalid_argument("Unable to open matrix file: " + path);
+    }
+
+    struct stat status;
+
+    if (fstat(descriptor, &status) < 0) {
+        close(descriptor);
+
+        throw std::invalid_argument("Unable to read matrix file: " + path);
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+
+    if (m_size > 0) {
+        void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (data == MAP_FAILED) {
+            close(descriptor);
+
+            throw std::invalid_argument("Unable to map matrix file: " + path);
+        }
+
+        madvise(data, m_size, MADV_SEQUENTIAL);
+
+        m_data = static_cast<char const *>(data);
+    }
+
+    close(descriptor);
+}
+
+MatrixLoader::MappedFile::~MappedFile()
+{
+    if (m_data) {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+}
+
+char const *MatrixLoader::MappedFile::Data() const
+{
+    return m_data;
+}
+
+size_t MatrixLoader::MappedFile::Size() const
+{
+    return m_size;
+}
+
+Matrix MatrixLoader::LoadCSV(std::string const &path, char const &delimiter)
+{
+    MappedFile file(path);
+
+    char const *position = file.Data();
+    char const *end = file.Data() + file.Size();
+
+    std::vector<double> real;
+
+    size_t rows = 0;
+    size_t cols = 0;
+
+    while (position < end) {
+        char const *line_end = static_cast<char const *>(std::memchr(position, '\n', end - position));
+
+        if (!line_end) {
+            line_end = end;
+        }
+
+        char const *row_end = line_end > position && *(line_end - 1) == '\r' ? line_end - 1 : line_end;
+
+        if (row_end > position) {
+            size_t const size = real.size();
+
+            ParseRow(position, row_end, delimiter, real);
+
+            if (rows == 0) {
+                cols = real.size();
+            }
+            else if (real.size() - size != cols) {
+                throw std::invalid_argument("Matrix is ill-formed: row " + std::to_string(rows) + " of " + path);
+            }
+
+            ++rows;
+        }
+
+        position = line_end + 1;
+    }
+
+    if (rows == 0) {
+        throw std::invalid_argument("Matrix file is empty: " + path);
+    }
+
+    return Matrix(NumericMatrix(rows, cols, real));
+}
+
+Matrix MatrixLoader::LoadBinary(std::string const &path, size_t const &rows, size_t const &cols, bool const &complex)
+{
+    size_t const width = complex ? 2 : 1;
+
+    // A wrapped count could match the size of a small file while the dimensions claim a huge matrix
+    if (cols != 0 && rows > std::numeric_limits<size_t>::max() / cols / width / sizeof(double)) {
+        throw std::invalid_argument("Matrix dimensions are too large: " + path);
+    }
+
+    MappedFile file(path);
+
+    size_t const count = rows * cols * width;
+
+    if (file.Size() != count * sizeof(double)) {
+        throw std::invalid_argument("Matrix file size does not match dimensions: " + path);
+    }
+
+    std::vector<double> values(count);
+
+    // Files are little-endian IEEE 754 doubles, interleaved real and imaginary parts when complex
+    std::memcpy(values.data(), file.Data(), file.Size());
+
+    uint16_t const probe = 1;
+
+    if (*reinterpret_cast<uint8_t const *>(&probe) != 1) {
+        for (double &value : values) {
+            uint8_t *bytes = reinterpret_cast<uint8_t *>(&value);
+
+            std::reverse(bytes, bytes + sizeof(double));
+        }
+    }
+
+    if (!complex) {
+        return Matrix(NumericMatrix(rows, cols, values));
+    }
+
+    std::vector<double> real(rows * cols);
+    std::vector<double> imag(rows * cols);
+
+    for (size_t i = 0; i < rows * cols; ++i) {
+        real[i] = values[2 * i];
+        imag[i] = values[2 * i + 1];
+    }
+
+    return Matrix(NumericMatrix(rows, cols, real, imag));
+}
+
+void MatrixLoader::ParseRow(char const *begin, char const *end, char const &delimiter, std::vector<double> &real)
+{
+    char const *position = begin;
+
+    while (true) {
+        while (position < end && (*position == ' ' || *position == '\t')) {
+            ++position;
+        }
+
+        // from_chars does not accept a leading plus sign
+        if (position < end && *position == '+') {
+            ++position;
+        }
+
+        double value;
+
+        std::from_chars_result result = std::from_chars(position, end, value);
+
+        if (result.ec != std::errc()) {
+            throw std::invalid_argument("Invalid matrix entry: " + std::string(position, std::find(position, end, delimiter)));
+        }
+
+        real.push_back(value);
+
+        position = result.ptr;
+
+        while (position < end && (*position == ' ' || *position == '\t')) {
+            ++position;
+        }
+
+        if (position == end) {
+            return;
+        }
+
+        if (*position != delimiter) {
+            throw std::invalid_argument("Invalid matrix entry: " + std::string(begin, end));
+        }
+
+        ++position;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "numeric_matrix.hpp"
+
+class MatrixLoader
+{
+    // Read-only memory mapping of a whole file, released on destruction
+    class MappedFile
+    {
+        char const *m_data;
+        size_t m_size;
+
+    public:
+        MappedFile(std::string const &path);
+        ~MappedFile();
+
+        MappedFile(MappedFile const &) = delete;
+        MappedFile &operator=(MappedFile const &) = delete;
+
+        char const *Data() const;
+        size_t Size() const;
+    };
+
+public:
+    static Matrix LoadCSV(std::string const &path, char const &delimiter = ',');
+    static Matrix LoadBinary(std::string const &path, size_t const &rows, size_t const &cols, bool const &complex = false);
+
+private:
+    static void ParseRow(char const *begin, char const *end, char const &delimiter, std::vector<double> &real);
+};
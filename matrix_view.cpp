@@ -0,0 +1,78 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "matrix_view.hpp"
+
+MatrixView::MatrixView(std::shared_ptr<std::vector<Scalar> const> const &elements, size_t const &stride, std::vector<size_t> const &rows, std::vector<size_t> const &cols) : m_elements(elements), m_stride(stride), m_rows(rows), m_cols(cols), m_transposed(false)
+{
+}
+
+size_t MatrixView::Rows() const
+{
+    return m_transposed ? m_cols.size() : m_rows.size();
+}
+
+size_t MatrixView::Cols() const
+{
+    return m_transposed ? m_rows.size() : m_cols.size();
+}
+
+Scalar const &MatrixView::operator()(size_t const &row, size_t const &col) const
+{
+    if (m_transposed) {
+        return (*m_elements)[m_rows[col] * m_stride + m_cols[row]];
+    }
+
+    return (*m_elements)[m_rows[row] * m_stride + m_cols[col]];
+}
+
+MatrixView MatrixView::Transpose() const
+{
+    MatrixView view(*this);
+
+    view.m_transposed = !m_transposed;
+
+    return view;
+}
+
+MatrixView MatrixView::Slice(std::vector<size_t> const &rows, std::vector<size_t> const &cols) const
+{
+    std::vector<size_t> const &parent_rows = m_transposed ? m_cols : m_rows;
+    std::vector<size_t> const &parent_cols = m_transposed ? m_rows : m_cols;
+
+    std::vector<size_t> sliced_rows(rows.size());
+    std::vector<size_t> sliced_cols(cols.size());
+
+    std::transform(std::cbegin(rows), std::cend(rows), std::begin(sliced_rows), [&parent_rows](size_t const &row) -> size_t { return parent_rows[row]; });
+    std::transform(std::cbegin(cols), std::cend(cols), std::begin(sliced_cols), [&parent_cols](size_t const &col) -> size_t { return parent_cols[col]; });
+
+    MatrixView view(*this);
+
+    // Slices are composed onto the parent's indices, so nested views never chain lookups
+    if (m_transposed) {
+        view.m_rows = std::move(sliced_cols);
+        view.m_cols = std::move(sliced_rows);
+    }
+    else {
+        view.m_rows = std::move(sliced_rows);
+        view.m_cols = std::move(sliced_cols);
+    }
+
+    return view;
+}
+
+std::vector<Scalar> MatrixView::Materialize() const
+{
+    std::vector<Scalar> elements;
+
+    elements.reserve(Rows() * Cols());
+
+    for (size_t i = 0; i < Rows(); ++i) {
+        for (size_t j = 0; j < Cols(); ++j) {
+            elements.push_back((*this)(i, j));
+        }
+    }
+
+    return elements;
+}
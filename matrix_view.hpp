@@ -0,0 +1,37 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+
+#include "node.hpp"
+
+class MatrixView
+{
+    std::shared_ptr<std::vector<Scalar> const> m_elements;
+    size_t m_stride;
+
+    // Parent row and column indices in the parent's orientation, transposing only swaps their roles
+    std::vector<size_t> m_rows;
+    std::vector<size_t> m_cols;
+
+    bool m_transposed;
+
+public:
+    MatrixView(std::shared_ptr<std::vector<Scalar> const> const &elements, size_t const &stride, std::vector<size_t> const &rows, std::vector<size_t> const &cols);
+
+    size_t Rows() const;
+    size_t Cols() const;
+
+    Scalar const &operator()(size_t const &row, size_t const &col) const;
+
+    MatrixView Transpose() const;
+    MatrixView Slice(std::vector<size_t> const &rows, std::vector<size_t> const &cols) const;
+
+    std::vector<Scalar> Materialize() const;
+};
@@ -37,11 +37,30 @@ std::string Node::Type() const
     return "Node";
 }
 
+Scalar Node::Clone() const
+{
+    return Scalar(new Node(*this));
+}
+
 std::complex<double> Node::Value() const
 {
     return m_value;
 }
 
+Scalar Node::Rebuild(Scalar const &scalar, std::vector<Scalar> const &arguments)
+{
+    // Nodes are never rewritten in place, an unchanged node is shared and a changed one is copied with its new arguments
+    if (std::equal(std::cbegin(arguments), std::cend(arguments), std::cbegin(scalar->m_arguments), std::cend(scalar->m_arguments))) {
+        return scalar;
+    }
+
+    Scalar rebuilt = scalar->Clone();
+
+    rebuilt->m_arguments = arguments;
+
+    return rebuilt;
+}
+
 bool Node::Equivalent(Scalar const &lhs_ptr, Scalar const &rhs_ptr)
 { 
     if (lhs_ptr->Type() == rhs_ptr->Type()) {
@@ -70,6 +89,22 @@ bool Node::Equivalent(Scalar const &lhs_ptr, Scalar const &rhs_ptr)
     return false;
 }
 
+bool Node::Constant(Scalar const &scalar)
+{
+    if (scalar->Type() == "VariableNode") {
+        return false;
+    }
+
+    std::vector<Scalar> const &arguments = scalar->m_arguments;
+
+    return std::all_of(std::cbegin(arguments), std::cend(arguments), [](Scalar const &argument) -> bool { return Node::Constant(argument); });
+}
+
+bool Node::Zero(Scalar const &scalar)
+{
+    return scalar->Type() == "ConstantNode" && Approximately(scalar->Value(), 0.0);
+}
+
 std::ostream &operator<<(std::ostream &ostream, Node const &node)
 {
     std::complex<double> complex = node.Value();
@@ -36,11 +36,15 @@ public:
     std::vector<Scalar> Arguments() const;
 
     virtual std::string Type() const;
+    virtual Scalar Clone() const;
 
     virtual std::complex<double> Value() const;
 
 public:
+    static Scalar Rebuild(Scalar const &scalar, std::vector<Scalar> const &arguments);
     static bool Equivalent(Scalar const &lhs_ptr, Scalar const &rhs_ptr);
+    static bool Constant(Scalar const &scalar);
+    static bool Zero(Scalar const &scalar);
 
     friend std::ostream &operator<<(std::ostream &ostream, Node const &node);
     friend std::ostream &operator<<(std::ostream &ostream, Scalar const &scalar);
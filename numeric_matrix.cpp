@@ -0,0 +1,241 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "numeric_matrix.hpp"
+
+NumericMatrix::NumericMatrix() : m_rows(0), m_cols(0)
+{
+}
+
+NumericMatrix::NumericMatrix(size_t const &rows, size_t const &cols) : m_rows(rows), m_cols(cols), m_real(rows * cols)
+{
+}
+
+NumericMatrix::NumericMatrix(size_t const &rows, size_t const &cols, std::vector<double> const &real) : m_rows(rows), m_cols(cols), m_real(real)
+{
+    if (m_real.size() != rows * cols) {
+        throw std::invalid_argument("NumericMatrix: Element count does not match dimensions");
+    }
+}
+
+NumericMatrix::NumericMatrix(size_t const &rows, size_t const &cols, std::vector<double> const &real, std::vector<double> const &imag) : m_rows(rows), m_cols(cols), m_real(real), m_imag(imag)
+{
+    if (m_real.size() != rows * cols || (!m_imag.empty() && m_imag.size() != rows * cols)) {
+        throw std::invalid_argument("NumericMatrix: Element count does not match dimensions");
+    }
+}
+
+size_t NumericMatrix::Rows() const
+{
+    return m_rows;
+}
+
+size_t NumericMatrix::Cols() const
+{
+    return m_cols;
+}
+
+bool NumericMatrix::Real() const
+{
+    return m_imag.empty();
+}
+
+std::complex<double> NumericMatrix::operator()(size_t const &row, size_t const &col) const
+{
+    size_t const index = row * m_cols + col;
+
+    return std::complex<double>(m_real[index], m_imag.empty() ? 0.0 : m_imag[index]);
+}
+
+void NumericMatrix::Set(size_t const &row, size_t const &col, std::complex<double> const &value)
+{
+    size_t const index = row * m_cols + col;
+
+    if (value.imag() != 0.0) {
+        MakeComplex();
+    }
+
+    m_real[index] = value.real();
+
+    if (!m_imag.empty()) {
+        m_imag[index] = value.imag();
+    }
+}
+
+double *NumericMatrix::RealData()
+{
+    return m_real.data();
+}
+
+double const *NumericMatrix::RealData() const
+{
+    return m_real.data();
+}
+
+double *NumericMatrix::ImagData()
+{
+    return m_imag.empty() ? nullptr : m_imag.data();
+}
+
+double const *NumericMatrix::ImagData() const
+{
+    return m_imag.empty() ? nullptr : m_imag.data();
+}
+
+NumericMatrix NumericMatrix::Add(NumericMatrix const &other) const
+{
+    if (m_rows != other.m_rows || m_cols != other.m_cols) {
+        throw std::invalid_argument("NumericMatrix: Dimensions are not equal");
+    }
+
+    NumericMatrix matrix(*this);
+
+    std::transform(std::cbegin(matrix.m_real), std::cend(matrix.m_real), std::cbegin(other.m_real), std::begin(matrix.m_real), std::plus<double>());
+
+    if (!other.Real()) {
+        matrix.MakeComplex();
+
+        std::transform(std::cbegin(matrix.m_imag), std::cend(matrix.m_imag), std::cbegin(other.m_imag), std::begin(matrix.m_imag), std::plus<double>());
+    }
+
+    return matrix;
+}
+
+NumericMatrix NumericMatrix::Subtract(NumericMatrix const &other) const
+{
+    if (m_rows != other.m_rows || m_cols != other.m_cols) {
+        throw std::invalid_argument("NumericMatrix: Dimensions are not equal");
+    }
+
+    NumericMatrix matrix(*this);
+
+    std::transform(std::cbegin(matrix.m_real), std::cend(matrix.m_real), std::cbegin(other.m_real), std::begin(matrix.m_real), std::minus<double>());
+
+    if (!other.Real()) {
+        matrix.MakeComplex();
+
+        std::transform(std::cbegin(matrix.m_imag), std::cend(matrix.m_imag), std::cbegin(other.m_imag), std::begin(matrix.m_imag), std::minus<double>());
+    }
+
+    return matrix;
+}
+
+NumericMatrix NumericMatrix::Multiply(NumericMatrix const &other) const
+{
+    if (m_cols != other.m_rows) {
+        throw std::invalid_argument("NumericMatrix: LHS cols must equal RHS rows");
+    }
+
+    NumericMatrix matrix(m_rows, other.m_cols);
+
+    // (a + bi)(c + di) = (ac - bd) + (ad + bc)i, each term is one real GEMM
+    Gemm(m_rows, other.m_cols, m_cols, RealData(), other.RealData(), matrix.RealData(), 1.0);
+
+    if (!Real() || !other.Real()) {
+        matrix.MakeComplex();
+
+        if (!Real() && !other.Real()) {
+            Gemm(m_rows, other.m_cols, m_cols, ImagData(), other.ImagData(), matrix.RealData(), -1.0);
+        }
+
+        if (!other.Real()) {
+            Gemm(m_rows, other.m_cols, m_cols, RealData(), other.ImagData(), matrix.ImagData(), 1.0);
+        }
+
+        if (!Real()) {
+            Gemm(m_rows, other.m_cols, m_cols, ImagData(), other.RealData(), matrix.ImagData(), 1.0);
+        }
+    }
+
+    return matrix;
+}
+
+NumericMatrix NumericMatrix::Scale(std::complex<double> const &factor) const
+{
+    NumericMatrix matrix(m_rows, m_cols);
+
+    if (factor.imag() != 0.0 || !Real()) {
+        matrix.MakeComplex();
+    }
+
+    for (size_t index = 0; index < m_real.size(); ++index) {
+        double const imag = m_imag.empty() ? 0.0 : m_imag[index];
+
+        matrix.m_real[index] = m_real[index] * factor.real() - imag * factor.imag();
+
+        if (!matrix.m_imag.empty()) {
+            matrix.m_imag[index] = m_real[index] * factor.imag() + imag * factor.real();
+        }
+    }
+
+    return matrix;
+}
+
+NumericMatrix NumericMatrix::Transpose() const
+{
+    NumericMatrix matrix(m_cols, m_rows);
+
+    Transpose(m_rows, m_cols, RealData(), matrix.RealData());
+
+    if (!Real()) {
+        matrix.MakeComplex();
+
+        Transpose(m_rows, m_cols, ImagData(), matrix.ImagData());
+    }
+
+    return matrix;
+}
+
+void NumericMatrix::MakeComplex()
+{
+    if (m_imag.empty()) {
+        m_imag.resize(m_real.size(), 0.0);
+    }
+}
+
+// result += alpha * lhs * rhs, tiled so a block of rhs stays cache-resident while the contiguous inner loop vectorizes
+void NumericMatrix::Gemm(size_t const &rows, size_t const &cols, size_t const &inner, double const *lhs, double const *rhs, double *result, double const &alpha)
+{
+    for (size_t ii = 0; ii < rows; ii += block_size) {
+        size_t const i_end = std::min(ii + block_size, rows);
+
+        for (size_t kk = 0; kk < inner; kk += block_size) {
+            size_t const k_end = std::min(kk + block_size, inner);
+
+            for (size_t jj = 0; jj < cols; jj += block_size) {
+                size_t const j_end = std::min(jj + block_size, cols);
+
+                for (size_t i = ii; i < i_end; ++i) {
+                    double *result_row = result + i * cols;
+
+                    for (size_t k = kk; k < k_end; ++k) {
+                        double const lhs_ik = alpha * lhs[i * inner + k];
+                        double const *rhs_row = rhs + k * cols;
+
+                        for (size_t j = jj; j < j_end; ++j) {
+                            result_row[j] += lhs_ik * rhs_row[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void NumericMatrix::Transpose(size_t const &rows, size_t const &cols, double const *source, double *destination)
+{
+    for (size_t ii = 0; ii < rows; ii += block_size) {
+        size_t const i_end = std::min(ii + block_size, rows);
+
+        for (size_t jj = 0; jj < cols; jj += block_size) {
+            size_t const j_end = std::min(jj + block_size, cols);
+
+            for (size_t i = ii; i < i_end; ++i) {
+                for (size_t j = jj; j < j_end; ++j) {
+                    destination[j * rows + i] = source[i * cols + j];
+                }
+            }
+        }
+    }
+}
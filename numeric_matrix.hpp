@@ -0,0 +1,54 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+class NumericMatrix
+{
+    size_t m_rows;
+    size_t m_cols;
+
+    // Planar storage so the kernels stream over contiguous doubles; the imaginary plane is empty while every entry is real
+    std::vector<double> m_real;
+    std::vector<double> m_imag;
+
+public:
+    static constexpr size_t block_size = 64;
+
+    NumericMatrix();
+    NumericMatrix(size_t const &rows, size_t const &cols);
+    NumericMatrix(size_t const &rows, size_t const &cols, std::vector<double> const &real);
+    NumericMatrix(size_t const &rows, size_t const &cols, std::vector<double> const &real, std::vector<double> const &imag);
+
+    size_t Rows() const;
+    size_t Cols() const;
+    bool Real() const;
+
+    std::complex<double> operator()(size_t const &row, size_t const &col) const;
+    void Set(size_t const &row, size_t const &col, std::complex<double> const &value);
+
+    double *RealData();
+    double const *RealData() const;
+    double *ImagData();
+    double const *ImagData() const;
+
+    NumericMatrix Add(NumericMatrix const &other) const;
+    NumericMatrix Subtract(NumericMatrix const &other) const;
+    NumericMatrix Multiply(NumericMatrix const &other) const;
+    NumericMatrix Scale(std::complex<double> const &factor) const;
+    NumericMatrix Transpose() const;
+
+private:
+    void MakeComplex();
+
+    static void Gemm(size_t const &rows, size_t const &cols, size_t const &inner, double const *lhs, double const *rhs, double *result, double const &alpha);
+    static void Transpose(size_t const &rows, size_t const &cols, double const *source, double *destination);
+};
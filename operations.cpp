@@ -16,6 +16,11 @@ std::string ExponentiationNode::Type() const
     return "ExponentiationNode";
 }
 
+Scalar ExponentiationNode::Clone() const
+{
+    return Scalar(new ExponentiationNode(*this));
+}
+
 std::complex<double> ExponentiationNode::Value() const
 {
     return std::pow(Argument(0)->Value(), Argument(1)->Value());
@@ -33,6 +38,11 @@ std::string MultiplicationNode::Type() const
     return "MultiplicationNode";
 }
 
+Scalar MultiplicationNode::Clone() const
+{
+    return Scalar(new MultiplicationNode(*this));
+}
+
 std::complex<double> MultiplicationNode::Value() const
 {
     return Argument(0)->Value() * Argument(1)->Value();
@@ -50,6 +60,11 @@ std::string DivisionNode::Type() const
     return "DivisionNode";
 }
 
+Scalar DivisionNode::Clone() const
+{
+    return Scalar(new DivisionNode(*this));
+}
+
 std::complex<double> DivisionNode::Value() const
 {
     return Argument(0)->Value() / Argument(1)->Value();
@@ -67,6 +82,11 @@ std::string AdditionNode::Type() const
     return "AdditionNode";
 }
 
+Scalar AdditionNode::Clone() const
+{
+    return Scalar(new AdditionNode(*this));
+}
+
 std::complex<double> AdditionNode::Value() const
 {
     return Argument(0)->Value() + Argument(1)->Value();
@@ -84,6 +104,11 @@ std::string SubtractionNode::Type() const
     return "SubtractionNode";
 }
 
+Scalar SubtractionNode::Clone() const
+{
+    return Scalar(new SubtractionNode(*this));
+}
+
 std::complex<double> SubtractionNode::Value() const
 {
     return Argument(0)->Value() - Argument(1)->Value();
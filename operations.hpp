@@ -17,6 +17,7 @@ public:
     AdditionNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -27,6 +28,7 @@ public:
     SubtractionNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -37,6 +39,7 @@ public:
     MultiplicationNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -47,6 +50,7 @@ public:
     DivisionNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -57,6 +61,7 @@ public:
     ExponentiationNode(std::initializer_list<Scalar> const &arguments);
 
     std::string Type() const override;
+    Scalar Clone() const override;
 
     std::complex<double> Value() const override;
 };
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "polynomial.hpp"
+
+Polynomial Polynomial::Variable(size_t const &index)
+{
+    Polynomial polynomial;
+
+    polynomial.m_terms.emplace(Monomial{ { index, 1 } }, 1.0);
+
+    return polynomial;
+}
+
+Polynomial::Polynomial()
+{
+}
+
+Polynomial::Polynomial(std::complex<double> const &constant)
+{
+    Accumulate(Monomial(), constant);
+}
+
+size_t Polynomial::Terms() const
+{
+    return m_terms.size();
+}
+
+Polynomial::TermMap const &Polynomial::Coefficients() const
+{
+    return m_terms;
+}
+
+Polynomial Polynomial::Add(Polynomial const &other) const
+{
+    Polynomial sum = *this;
+
+    sum.Accumulate(other);
+
+    return sum;
+}
+
+Polynomial Polynomial::Subtract(Polynomial const &other) const
+{
+    Polynomial difference = *this;
+
+    difference.Accumulate(other, -1.0);
+
+    return difference;
+}
+
+void Polynomial::Accumulate(Polynomial const &other, std::complex<double> const &factor)
+{
+    for (auto const &[monomial, coefficient] : other.m_terms) {
+        Accumulate(monomial, coefficient * factor);
+    }
+}
+
+Polynomial Polynomial::Multiply(Polynomial const &other, size_t const &limit) const
+{
+    Polynomial product;
+
+    // Like terms are collected as they are produced, so the product never holds more than its distinct monomials
+    for (auto const &[lhs_monomial, lhs_coefficient] : m_terms) {
+        for (auto const &[rhs_monomial, rhs_coefficient] : other.m_terms) {
+            Monomial monomial;
+
+            auto lhs_it = std::cbegin(lhs_monomial);
+            auto rhs_it = std::cbegin(rhs_monomial);
+
+            // Both are sorted by index, so their exponents are added in one merge
+            while (lhs_it != std::cend(lhs_monomial) || rhs_it != std::cend(rhs_monomial)) {
+                if (rhs_it == std::cend(rhs_monomial) || (lhs_it != std::cend(lhs_monomial) && lhs_it->first < rhs_it->first)) {
+                    monomial.push_back(*lhs_it++);
+                }
+                else if (lhs_it == std::cend(lhs_monomial) || rhs_it->first < lhs_it->first) {
+                    monomial.push_back(*rhs_it++);
+                }
+                else {
+                    monomial.emplace_back(lhs_it->first, lhs_it->second + rhs_it->second);
+
+                    ++lhs_it;
+                    ++rhs_it;
+                }
+            }
+
+            product.Accumulate(monomial, lhs_coefficient * rhs_coefficient);
+
+            if (product.m_terms.size() > limit) {
+                throw std::length_error("Polynomial: Product exceeds the maximum number of terms");
+            }
+        }
+    }
+
+    return product;
+}
+
+Polynomial Polynomial::Scale(std::complex<double> const &factor) const
+{
+    Polynomial scaled;
+
+    for (auto const &[monomial, coefficient] : m_terms) {
+        scaled.Accumulate(monomial, coefficient * factor);
+    }
+
+    return scaled;
+}
+
+Polynomial Polynomial::Pow(uint32_t exponent, size_t const &limit) const
+{
+    Polynomial power(1.0);
+    Polynomial base = *this;
+
+    while (exponent > 0) {
+        if (exponent & 1) {
+            power = power.Multiply(base, limit);
+        }
+
+        exponent >>= 1;
+
+        if (exponent > 0) {
+            base = base.Multiply(base, limit);
+        }
+    }
+
+    return power;
+}
+
+bool Polynomial::Natural(std::complex<double> const &exponent)
+{
+    return Approximately(exponent.imag(), 0.0) && exponent.real() >= 0.0 && exponent.real() <= std::numeric_limits<uint32_t>::max() && Approximately(exponent.real(), std::round(exponent.real()));
+}
+
+bool Polynomial::MonomialOrder::operator()(Monomial const &lhs, Monomial const &rhs) const
+{
+    for (size_t i = 0; i < lhs.size() && i < rhs.size(); ++i) {
+        // The monomial with the lower index has a nonzero exponent where the other one has zero
+        if (lhs[i].first != rhs[i].first) {
+            return lhs[i].first > rhs[i].first;
+        }
+        else if (lhs[i].second != rhs[i].second) {
+            return lhs[i].second < rhs[i].second;
+        }
+    }
+
+    return lhs.size() < rhs.size();
+}
+
+void Polynomial::Accumulate(Monomial const &monomial, std::complex<double> const &coefficient)
+{
+    auto const [term_it, inserted] = m_terms.emplace(monomial, coefficient);
+
+    if (!inserted) {
+        term_it->second += coefficient;
+    }
+
+    if (Approximately(term_it->second, 0.0)) {
+        m_terms.erase(term_it);
+    }
+}
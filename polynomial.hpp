@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <utility>
+#include <complex>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
+#include "utils.hpp"
+
+class Polynomial
+{
+public:
+    // Exponents of the variables that occur, as (index, exponent) pairs sorted by index, zero exponents are never stored
+    using Monomial = std::vector<std::pair<size_t, uint32_t>>;
+
+    // Orders monomials as if their exponents were written out densely by index and compared lexicographically
+    struct MonomialOrder
+    {
+        bool operator()(Monomial const &lhs, Monomial const &rhs) const;
+    };
+
+    using TermMap = std::map<Monomial, std::complex<double>, MonomialOrder>;
+
+private:
+    // Zero coefficients are never stored
+    TermMap m_terms;
+
+public:
+    static constexpr size_t max_terms = 100000;
+
+    static Polynomial Variable(size_t const &index);
+
+    Polynomial();
+    Polynomial(std::complex<double> const &constant);
+
+    size_t Terms() const;
+    TermMap const &Coefficients() const;
+
+    Polynomial Add(Polynomial const &other) const;
+    Polynomial Subtract(Polynomial const &other) const;
+
+    // Adds factor * other into this polynomial, without copying the terms it already has
+    void Accumulate(Polynomial const &other, std::complex<double> const &factor = 1.0);
+
+    Polynomial Multiply(Polynomial const &other, size_t const &limit = max_terms) const;
+    Polynomial Scale(std::complex<double> const &factor) const;
+    Polynomial Pow(uint32_t exponent, size_t const &limit = max_terms) const;
+
+    static bool Natural(std::complex<double> const &exponent);
+
+private:
+    void Accumulate(Monomial const &monomial, std::complex<double> const &coefficient);
+};
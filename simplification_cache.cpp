@@ -0,0 +1,121 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "simplification_cache.hpp"
+
+std::shared_ptr<SimplificationCache> const SimplificationCache::default_cache = std::make_shared<SimplificationCache>();
+
+SimplificationCache::SimplificationCache(size_t const &capacity) : m_capacity(capacity), m_hits(0), m_misses(0)
+{
+}
+
+Scalar SimplificationCache::Find(Pass const &pass, size_t const &hash, Scalar const &input)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto [index_it, index_end] = m_index.equal_range(hash);
+
+    for (; index_it != index_end; ++index_it) {
+        Entry const &entry = *index_it->second;
+
+        // Equal hashes are only a hint, the structure is compared before an entry is reused
+        if (entry.pass == pass && Identical(entry.input, input)) {
+            m_entries.splice(std::begin(m_entries), m_entries, index_it->second);
+
+            ++m_hits;
+
+            return entry.output;
+        }
+    }
+
+    ++m_misses;
+
+    return nullptr;
+}
+
+void SimplificationCache::Insert(Pass const &pass, size_t const &hash, Scalar const &input, Scalar const &output)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_capacity == 0) {
+        return;
+    }
+
+    m_entries.push_front({ pass, hash, input, output });
+    m_index.emplace(hash, std::begin(m_entries));
+
+    while (m_entries.size() > m_capacity) {
+        auto [index_it, index_end] = m_index.equal_range(m_entries.back().hash);
+
+        for (; index_it != index_end; ++index_it) {
+            if (index_it->second == std::prev(std::end(m_entries))) {
+                m_index.erase(index_it);
+
+                break;
+            }
+        }
+
+        m_entries.pop_back();
+    }
+}
+
+void SimplificationCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_entries.clear();
+    m_index.clear();
+
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t SimplificationCache::Capacity() const
+{
+    return m_capacity;
+}
+
+size_t SimplificationCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_entries.size();
+}
+
+size_t SimplificationCache::Hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_hits;
+}
+
+size_t SimplificationCache::Misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_misses;
+}
+
+bool SimplificationCache::Identical(Scalar const &lhs, Scalar const &rhs)
+{
+    if (lhs == rhs) {
+        return true;
+    }
+    else if (lhs->Type() != rhs->Type()) {
+        return false;
+    }
+    else if (lhs->Type() == "ConstantNode") {
+        return lhs->Value() == rhs->Value();
+    }
+
+    std::vector<Scalar> const &lhs_arguments = lhs->Arguments();
+    std::vector<Scalar> const &rhs_arguments = rhs->Arguments();
+
+    // Distinct leaves that are not constants are distinct variables
+    if (lhs_arguments.empty() || lhs_arguments.size() != rhs_arguments.size()) {
+        return false;
+    }
+
+    return std::equal(std::cbegin(lhs_arguments), std::cend(lhs_arguments), std::cbegin(rhs_arguments), [](Scalar const &lhs_argument, Scalar const &rhs_argument) -> bool { return Identical(lhs_argument, rhs_argument); });
+}
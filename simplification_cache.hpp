@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+
+#include "node.hpp"
+
+class SimplificationCache
+{
+public:
+    enum class Pass
+    {
+        Identify,
+        Distribute,
+        CombineFactors,
+        CombineAddends,
+        Factorize
+    };
+
+private:
+    struct Entry
+    {
+        Pass pass;
+        size_t hash;
+        Scalar input;
+        Scalar output;
+    };
+
+    size_t m_capacity;
+
+    // Most recently used entries first, the inputs are held so that their variables cannot be reused by another node
+    std::list<Entry> m_entries;
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> m_index;
+
+    size_t m_hits;
+    size_t m_misses;
+
+    mutable std::mutex m_mutex;
+
+public:
+    static constexpr size_t default_capacity = 1 << 16;
+
+    static std::shared_ptr<SimplificationCache> const default_cache;
+
+    SimplificationCache(size_t const &capacity = default_capacity);
+
+    Scalar Find(Pass const &pass, size_t const &hash, Scalar const &input);
+    void Insert(Pass const &pass, size_t const &hash, Scalar const &input, Scalar const &output);
+    void Clear();
+
+    size_t Capacity() const;
+    size_t Size() const;
+    size_t Hits() const;
+    size_t Misses() const;
+
+    static bool Identical(Scalar const &lhs, Scalar const &rhs);
+};
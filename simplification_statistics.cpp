@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "simplification_statistics.hpp"
+
+void SimplificationStatistics::Record(std::string const &pass, size_t const &nodes_in, size_t const &nodes_out, std::chrono::nanoseconds const &time)
+{
+    Pass &statistics = passes[pass];
+
+    statistics.calls += 1;
+    statistics.nodes_in += nodes_in;
+    statistics.nodes_out += nodes_out;
+    statistics.time += time;
+}
+
+void SimplificationStatistics::Merge(SimplificationStatistics const &other)
+{
+    for (auto const &[name, pass] : other.passes) {
+        Pass &statistics = passes[name];
+
+        statistics.calls += pass.calls;
+        statistics.nodes_in += pass.nodes_in;
+        statistics.nodes_out += pass.nodes_out;
+        statistics.time += pass.time;
+    }
+
+    for (auto const &[name, hits] : other.rules) {
+        rules[name] += hits;
+    }
+
+    cache_hits += other.cache_hits;
+    cache_misses += other.cache_misses;
+}
+
+std::string SimplificationStatistics::Json() const
+{
+    std::ostringstream json;
+
+    json << std::fixed << std::setprecision(3);
+    json << "{\"passes\":{";
+
+    for (auto pass_it = std::cbegin(passes); pass_it != std::cend(passes); ++pass_it) {
+        Pass const &pass = pass_it->second;
+
+        json << (pass_it == std::cbegin(passes) ? "" : ",") << "\"" << pass_it->first << "\":{"
+            << "\"calls\":" << pass.calls << ","
+            << "\"nodes_in\":" << pass.nodes_in << ","
+            << "\"nodes_out\":" << pass.nodes_out << ","
+            << "\"milliseconds\":" << std::chrono::duration<double, std::milli>(pass.time).count() << "}";
+    }
+
+    json << "},\"rules\":{";
+
+    for (auto rule_it = std::cbegin(rules); rule_it != std::cend(rules); ++rule_it) {
+        json << (rule_it == std::cbegin(rules) ? "" : ",") << "\"" << rule_it->first << "\":" << rule_it->second;
+    }
+
+    json << "},\"cache_hits\":" << cache_hits << ",\"cache_misses\":" << cache_misses << "}";
+
+    return json.str();
+}
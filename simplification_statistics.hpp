@@ -0,0 +1,34 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <string>
+#include <map>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+struct SimplificationStatistics
+{
+    struct Pass
+    {
+        size_t calls = 0;
+        size_t nodes_in = 0;
+        size_t nodes_out = 0;
+        std::chrono::nanoseconds time = std::chrono::nanoseconds(0);
+    };
+
+    // Keyed by pass and rule name, the rule counts cover rewrites that were not answered by the memo cache
+    std::map<std::string, Pass> passes;
+    std::map<std::string, size_t> rules;
+
+    size_t cache_hits = 0;
+    size_t cache_misses = 0;
+
+    void Record(std::string const &pass, size_t const &nodes_in, size_t const &nodes_out, std::chrono::nanoseconds const &time);
+    void Merge(SimplificationStatistics const &other);
+
+    std::string Json() const;
+};
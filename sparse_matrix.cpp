@@ -0,0 +1,381 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "sparse_matrix.hpp"
+#include "operations.hpp"
+
+
+SparseMatrix SparseMatrix::Identity(size_t const &dim)
+{
+    SparseMatrix identity(dim, dim);
+
+    Scalar one(new ConstantNode(1.0));
+
+    identity.m_row_offsets.clear();
+    identity.m_row_offsets.emplace_back(0);
+
+    for (size_t i = 0; i < dim; ++i) {
+        identity.Append(i, one);
+        identity.EndRow();
+    }
+
+    return identity;
+}
+
+bool SparseMatrix::Worthwhile(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements)
+{
+    if (rows * cols < min_elements) {
+        return false;
+    }
+
+    size_t non_zeros = std::count_if(std::cbegin(elements), std::cend(elements), [](Scalar const &element) -> bool { return !Absent(element); });
+
+    return non_zeros * max_density <= rows * cols;
+}
+
+bool SparseMatrix::Absent(Scalar const &scalar)
+{
+    return scalar->Type() == "ConstantNode" && scalar->Value() == std::complex<double>(0.0, 0.0);
+}
+
+SparseMatrix::SparseMatrix() : m_rows(0), m_cols(0), m_row_offsets(1, 0)
+{
+}
+
+SparseMatrix::SparseMatrix(size_t const &rows, size_t const &cols) : m_rows(rows), m_cols(cols), m_row_offsets(rows + 1, 0)
+{
+}
+
+SparseMatrix::SparseMatrix(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements) : m_rows(rows), m_cols(cols), m_row_offsets(1, 0)
+{
+    if (elements.size() != rows * cols) {
+        throw std::invalid_argument("SparseMatrix: Element count does not match dimensions");
+    }
+
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            if (!Absent(elements[i * cols + j])) {
+                Append(j, elements[i * cols + j]);
+            }
+        }
+
+        EndRow();
+    }
+}
+
+SparseMatrix::SparseMatrix(size_t const &rows, size_t const &cols, std::vector<std::tuple<size_t, size_t, Scalar>> const &triplets) : m_rows(rows), m_cols(cols), m_row_offsets(1, 0)
+{
+    std::vector<std::tuple<size_t, size_t, Scalar>> sorted(triplets);
+
+    std::stable_sort(std::begin(sorted), std::end(sorted), 
+        [](std::tuple<size_t, size_t, Scalar> const &lhs, std::tuple<size_t, size_t, Scalar> const &rhs) -> bool { 
+            return std::make_pair(std::get<0>(lhs), std::get<1>(lhs)) < std::make_pair(std::get<0>(rhs), std::get<1>(rhs)); 
+        });
+
+    auto triplet_it = std::cbegin(sorted);
+
+    for (size_t i = 0; i < rows; ++i) {
+        for (; triplet_it != std::cend(sorted) && std::get<0>(*triplet_it) == i; ++triplet_it) {
+            auto const &[row, col, value] = *triplet_it;
+
+            if (col >= cols) {
+                throw std::out_of_range("SparseMatrix: Triplet index out of range");
+            }
+
+            // Duplicate entries are summed
+            if (m_values.size() > m_row_offsets.back() && m_col_indices.back() == col) {
+                m_values.back() = Sum(m_values.back(), value);
+            }
+            else if (!Absent(value)) {
+                Append(col, value);
+            }
+        }
+
+        EndRow();
+    }
+
+    if (triplet_it != std::cend(sorted)) {
+        throw std::out_of_range("SparseMatrix: Triplet index out of range");
+    }
+}
+
+size_t SparseMatrix::Rows() const
+{
+    return m_rows;
+}
+
+size_t SparseMatrix::Cols() const
+{
+    return m_cols;
+}
+
+size_t SparseMatrix::NonZeros() const
+{
+    return m_values.size();
+}
+
+Scalar SparseMatrix::operator()(size_t const &row, size_t const &col) const
+{
+    size_t const index = Index(row, col);
+
+    if (index < m_values.size()) {
+        return m_values[index];
+    }
+
+    return Scalar(new ConstantNode(0.0));
+}
+
+bool SparseMatrix::Stored(size_t const &row, size_t const &col) const
+{
+    return Index(row, col) < m_values.size();
+}
+
+std::complex<double> SparseMatrix::Value(size_t const &row, size_t const &col) const
+{
+    return (*this)(row, col)->Value();
+}
+
+bool SparseMatrix::Numeric() const
+{
+    return std::all_of(std::cbegin(m_values), std::cend(m_values), [](Scalar const &value) -> bool { return Node::Constant(value); });
+}
+
+std::vector<size_t> const &SparseMatrix::RowOffsets() const
+{
+    return m_row_offsets;
+}
+
+std::vector<size_t> const &SparseMatrix::ColIndices() const
+{
+    return m_col_indices;
+}
+
+std::vector<Scalar> const &SparseMatrix::Values() const
+{
+    return m_values;
+}
+
+SparseMatrix SparseMatrix::Add(SparseMatrix const &other) const
+{
+    return Merge(other, false);
+}
+
+SparseMatrix SparseMatrix::Subtract(SparseMatrix const &other) const
+{
+    return Merge(other, true);
+}
+
+// Row-by-row Gustavson product, O(flops) with a dense accumulator over the touched columns only
+SparseMatrix SparseMatrix::Multiply(SparseMatrix const &other) const
+{
+    if (m_cols != other.m_rows) {
+        throw std::invalid_argument("SparseMatrix: LHS cols must equal RHS rows");
+    }
+
+    SparseMatrix matrix(m_rows, other.m_cols);
+
+    matrix.m_row_offsets.assign(1, 0);
+
+    std::vector<Scalar> accumulator(other.m_cols);
+    std::vector<size_t> touched;
+
+    for (size_t i = 0; i < m_rows; ++i) {
+        for (size_t lhs_index = m_row_offsets[i]; lhs_index < m_row_offsets[i + 1]; ++lhs_index) {
+            size_t const k = m_col_indices[lhs_index];
+
+            for (size_t rhs_index = other.m_row_offsets[k]; rhs_index < other.m_row_offsets[k + 1]; ++rhs_index) {
+                size_t const j = other.m_col_indices[rhs_index];
+
+                Scalar product = Product(m_values[lhs_index], other.m_values[rhs_index]);
+
+                if (accumulator[j]) {
+                    accumulator[j] = Sum(accumulator[j], product);
+                }
+                else {
+                    accumulator[j] = product;
+
+                    touched.emplace_back(j);
+                }
+            }
+        }
+
+        std::sort(std::begin(touched), std::end(touched));
+
+        for (size_t const &j : touched) {
+            if (!Absent(accumulator[j])) {
+                matrix.Append(j, accumulator[j]);
+            }
+
+            accumulator[j] = nullptr;
+        }
+
+        touched.clear();
+
+        matrix.EndRow();
+    }
+
+    return matrix;
+}
+
+SparseMatrix SparseMatrix::Scale(Scalar const &factor) const
+{
+    if (Absent(factor)) {
+        return SparseMatrix(m_rows, m_cols);
+    }
+
+    SparseMatrix matrix(*this);
+
+    for (Scalar &value : matrix.m_values) {
+        value = Product(factor, value);
+    }
+
+    return matrix;
+}
+
+SparseMatrix SparseMatrix::Transpose() const
+{
+    SparseMatrix matrix(m_cols, m_rows);
+
+    matrix.m_col_indices.resize(m_values.size());
+    matrix.m_values.resize(m_values.size());
+
+    // Counting sort of the entries by column
+    for (size_t const &col : m_col_indices) {
+        ++matrix.m_row_offsets[col + 1];
+    }
+
+    std::partial_sum(std::cbegin(matrix.m_row_offsets), std::cend(matrix.m_row_offsets), std::begin(matrix.m_row_offsets));
+
+    std::vector<size_t> positions(std::cbegin(matrix.m_row_offsets), std::prev(std::cend(matrix.m_row_offsets)));
+
+    for (size_t i = 0; i < m_rows; ++i) {
+        for (size_t index = m_row_offsets[i]; index < m_row_offsets[i + 1]; ++index) {
+            size_t const position = positions[m_col_indices[index]]++;
+
+            matrix.m_col_indices[position] = i;
+            matrix.m_values[position] = m_values[index];
+        }
+    }
+
+    return matrix;
+}
+
+SparseMatrix SparseMatrix::Submatrix(size_t const &row, size_t const &col) const
+{
+    if (m_rows <= 1 || m_cols <= 1 || m_rows <= row || m_cols <= col) {
+        throw std::out_of_range("Invalid submatrix indices");
+    }
+
+    SparseMatrix matrix(m_rows - 1, m_cols - 1);
+
+    matrix.m_row_offsets.assign(1, 0);
+
+    for (size_t i = 0; i < m_rows; ++i) {
+        if (i == row) {
+            continue;
+        }
+
+        for (size_t index = m_row_offsets[i]; index < m_row_offsets[i + 1]; ++index) {
+            if (m_col_indices[index] != col) {
+                matrix.Append(m_col_indices[index] - (m_col_indices[index] > col ? 1 : 0), m_values[index]);
+            }
+        }
+
+        matrix.EndRow();
+    }
+
+    return matrix;
+}
+
+// Constant operands are folded so numeric sparse arithmetic allocates one node per non-zero
+Scalar SparseMatrix::Sum(Scalar const &lhs, Scalar const &rhs)
+{
+    if (lhs->Type() == "ConstantNode" && rhs->Type() == "ConstantNode") {
+        return Scalar(new ConstantNode(lhs->Value() + rhs->Value()));
+    }
+
+    return Scalar(new AdditionNode({ lhs, rhs }));
+}
+
+Scalar SparseMatrix::Difference(Scalar const &lhs, Scalar const &rhs)
+{
+    if (lhs->Type() == "ConstantNode" && rhs->Type() == "ConstantNode") {
+        return Scalar(new ConstantNode(lhs->Value() - rhs->Value()));
+    }
+
+    return Scalar(new SubtractionNode({ lhs, rhs }));
+}
+
+Scalar SparseMatrix::Product(Scalar const &lhs, Scalar const &rhs)
+{
+    if (lhs->Type() == "ConstantNode" && rhs->Type() == "ConstantNode") {
+        return Scalar(new ConstantNode(lhs->Value() * rhs->Value()));
+    }
+
+    return Scalar(new MultiplicationNode({ lhs, rhs }));
+}
+
+size_t SparseMatrix::Index(size_t const &row, size_t const &col) const
+{
+    auto row_begin = std::cbegin(m_col_indices) + m_row_offsets[row];
+    auto row_end = std::cbegin(m_col_indices) + m_row_offsets[row + 1];
+
+    auto col_it = std::lower_bound(row_begin, row_end, col);
+
+    if (col_it != row_end && *col_it == col) {
+        return std::distance(std::cbegin(m_col_indices), col_it);
+    }
+
+    return m_values.size();
+}
+
+SparseMatrix SparseMatrix::Merge(SparseMatrix const &other, bool const &subtract) const
+{
+    if (m_rows != other.m_rows || m_cols != other.m_cols) {
+        throw std::invalid_argument("SparseMatrix: Dimensions are not equal");
+    }
+
+    SparseMatrix matrix(m_rows, m_cols);
+
+    matrix.m_row_offsets.assign(1, 0);
+
+    for (size_t i = 0; i < m_rows; ++i) {
+        size_t lhs_index = m_row_offsets[i];
+        size_t rhs_index = other.m_row_offsets[i];
+
+        while (lhs_index < m_row_offsets[i + 1] || rhs_index < other.m_row_offsets[i + 1]) {
+            size_t const lhs_col = lhs_index < m_row_offsets[i + 1] ? m_col_indices[lhs_index] : m_cols;
+            size_t const rhs_col = rhs_index < other.m_row_offsets[i + 1] ? other.m_col_indices[rhs_index] : m_cols;
+
+            if (lhs_col < rhs_col) {
+                matrix.Append(lhs_col, m_values[lhs_index++]);
+            }
+            else if (rhs_col < lhs_col) {
+                matrix.Append(rhs_col, subtract ? Difference(Scalar(new ConstantNode(0.0)), other.m_values[rhs_index++]) : other.m_values[rhs_index++]);
+            }
+            else {
+                Scalar value = subtract ? Difference(m_values[lhs_index++], other.m_values[rhs_index++]) : Sum(m_values[lhs_index++], other.m_values[rhs_index++]);
+
+                if (!Absent(value)) {
+                    matrix.Append(lhs_col, value);
+                }
+            }
+        }
+
+        matrix.EndRow();
+    }
+
+    return matrix;
+}
+
+void SparseMatrix::Append(size_t const &col, Scalar const &value)
+{
+    m_col_indices.emplace_back(col);
+    m_values.emplace_back(value);
+}
+
+void SparseMatrix::EndRow()
+{
+    m_row_offsets.emplace_back(m_values.size());
+}
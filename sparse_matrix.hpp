@@ -0,0 +1,73 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <tuple>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "node.hpp"
+
+class SparseMatrix
+{
+    size_t m_rows;
+    size_t m_cols;
+
+    // Compressed sparse row storage, zero entries are never stored
+    std::vector<size_t> m_row_offsets;
+    std::vector<size_t> m_col_indices;
+    std::vector<Scalar> m_values;
+
+public:
+    static constexpr size_t min_elements = 64;
+    static constexpr size_t max_density = 4;
+
+    static SparseMatrix Identity(size_t const &dim);
+    static bool Worthwhile(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements);
+
+    // Only an exact zero constant is left out, values that are merely close to zero are still stored
+    static bool Absent(Scalar const &scalar);
+
+    SparseMatrix();
+    SparseMatrix(size_t const &rows, size_t const &cols);
+    SparseMatrix(size_t const &rows, size_t const &cols, std::vector<Scalar> const &elements);
+    SparseMatrix(size_t const &rows, size_t const &cols, std::vector<std::tuple<size_t, size_t, Scalar>> const &triplets);
+
+    size_t Rows() const;
+    size_t Cols() const;
+    size_t NonZeros() const;
+
+    // Entries that are not stored read as a new zero constant, use Stored to tell them apart from stored values
+    Scalar operator()(size_t const &row, size_t const &col) const;
+    bool Stored(size_t const &row, size_t const &col) const;
+    std::complex<double> Value(size_t const &row, size_t const &col) const;
+    bool Numeric() const;
+
+    std::vector<size_t> const &RowOffsets() const;
+    std::vector<size_t> const &ColIndices() const;
+    std::vector<Scalar> const &Values() const;
+
+    SparseMatrix Add(SparseMatrix const &other) const;
+    SparseMatrix Subtract(SparseMatrix const &other) const;
+    SparseMatrix Multiply(SparseMatrix const &other) const;
+    SparseMatrix Scale(Scalar const &factor) const;
+    SparseMatrix Transpose() const;
+    SparseMatrix Submatrix(size_t const &row, size_t const &col) const;
+
+    static Scalar Sum(Scalar const &lhs, Scalar const &rhs);
+    static Scalar Difference(Scalar const &lhs, Scalar const &rhs);
+    static Scalar Product(Scalar const &lhs, Scalar const &rhs);
+
+private:
+    size_t Index(size_t const &row, size_t const &col) const;
+
+    SparseMatrix Merge(SparseMatrix const &other, bool const &subtract) const;
+
+    void Append(size_t const &col, Scalar const &value);
+    void EndRow();
+};
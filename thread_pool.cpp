@@ -0,0 +1,214 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#include "thread_pool.hpp"
+
+thread_local bool ThreadPool::worker_thread = false;
+
+ThreadPool &ThreadPool::Default()
+{
+    static ThreadPool thread_pool;
+
+    return thread_pool;
+}
+
+ThreadPool::ThreadPool(size_t const &threads) : m_body(nullptr), m_generation(0), m_active(0), m_stop(false)
+{
+    // The calling thread participates in every loop, so it owns the last range
+    for (size_t i = 0; i <= threads; ++i) {
+        m_ranges.emplace_back(new Range());
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&ThreadPool::Work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stop = true;
+    }
+
+    m_started.notify_all();
+
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::Size() const
+{
+    return m_ranges.size();
+}
+
+void ThreadPool::ParallelFor(size_t const &count, std::function<void(size_t const &begin, size_t const &end)> const &body)
+{
+    if (count == 0) {
+        return;
+    }
+
+    if (count == 1 || m_threads.empty() || worker_thread) {
+        body(0, count);
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> job_lock(m_job_mutex);
+
+    // Every participant starts with an equal contiguous share
+    for (size_t i = 0; i < m_ranges.size(); ++i) {
+        std::lock_guard<std::mutex> range_lock(m_ranges[i]->mutex);
+
+        m_ranges[i]->begin = count * i / m_ranges.size();
+        m_ranges[i]->end = count * (i + 1) / m_ranges.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_body = &body;
+        m_exception = nullptr;
+        m_active = m_threads.size();
+
+        ++m_generation;
+    }
+
+    m_started.notify_all();
+
+    worker_thread = true;
+
+    Run(m_ranges.size() - 1);
+
+    worker_thread = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_finished.wait(lock, [this]() -> bool { return m_active == 0; });
+
+    m_body = nullptr;
+
+    if (m_exception) {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+void ThreadPool::Work(size_t const &index)
+{
+    worker_thread = true;
+
+    size_t generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_started.wait(lock, [this, &generation]() -> bool { return m_stop || m_generation != generation; });
+
+            if (m_stop) {
+                return;
+            }
+
+            generation = m_generation;
+        }
+
+        Run(index);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            --m_active;
+        }
+
+        m_finished.notify_one();
+    }
+}
+
+void ThreadPool::Run(size_t const &index)
+{
+    size_t chunk = 1;
+
+    size_t begin;
+    size_t end;
+
+    while (Claim(index, chunk, begin, end) || (Steal(index) && Claim(index, chunk, begin, end))) {
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+        try {
+            (*m_body)(begin, end);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+        }
+
+        // Cheap elements are claimed in growing batches, expensive ones stay fine-grained so they can still be stolen
+        std::chrono::steady_clock::duration const elapsed = std::chrono::steady_clock::now() - start;
+
+        if (elapsed * 2 < target_chunk_time) {
+            chunk *= 2;
+        }
+        else if (elapsed > target_chunk_time * 2 && chunk > 1) {
+            chunk /= 2;
+        }
+    }
+}
+
+bool ThreadPool::Claim(size_t const &index, size_t const &chunk, size_t &begin, size_t &end)
+{
+    Range &range = *m_ranges[index];
+
+    std::lock_guard<std::mutex> lock(range.mutex);
+
+    if (range.begin == range.end) {
+        return false;
+    }
+
+    begin = range.begin;
+    end = std::min(range.begin + chunk, range.end);
+
+    range.begin = end;
+
+    return true;
+}
+
+bool ThreadPool::Steal(size_t const &index)
+{
+    for (size_t offset = 1; offset < m_ranges.size(); ++offset) {
+        Range &victim = *m_ranges[(index + offset) % m_ranges.size()];
+
+        size_t begin;
+        size_t end;
+
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            if (victim.begin == victim.end) {
+                continue;
+            }
+
+            // Take the upper half, or the last element when only one remains
+            begin = victim.end - (victim.end - victim.begin + 1) / 2;
+            end = victim.end;
+
+            victim.end = begin;
+        }
+
+        Range &range = *m_ranges[index];
+
+        std::lock_guard<std::mutex> lock(range.mutex);
+
+        range.begin = begin;
+        range.end = end;
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Casey Sanchez
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+
+class ThreadPool
+{
+    // Half-open index range owned by one participant, the owner claims from the front and thieves split off the back
+    struct Range
+    {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::unique_ptr<Range>> m_ranges;
+
+    std::mutex m_job_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_started;
+    std::condition_variable m_finished;
+
+    std::function<void(size_t const &, size_t const &)> const *m_body;
+    std::exception_ptr m_exception;
+
+    size_t m_generation;
+    size_t m_active;
+    bool m_stop;
+
+    // Nested parallel loops run inline on the participant that reached them
+    static thread_local bool worker_thread;
+
+public:
+    // Chunks are resized so that each claim runs for roughly this long
+    static constexpr std::chrono::microseconds target_chunk_time = std::chrono::microseconds(200);
+
+    static ThreadPool &Default();
+
+    ThreadPool(size_t const &threads = std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    size_t Size() const;
+
+    void ParallelFor(size_t const &count, std::function<void(size_t const &begin, size_t const &end)> const &body);
+
+private:
+    void Work(size_t const &index);
+    void Run(size_t const &index);
+
+    bool Claim(size_t const &index, size_t const &chunk, size_t &begin, size_t &end);
+    bool Steal(size_t const &index);
+};